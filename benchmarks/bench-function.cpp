@@ -0,0 +1,69 @@
+#include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+
+#include "function.hpp"
+
+namespace {
+using Capture = std::array<int, 6>;
+constexpr auto num_calls = 1000;
+
+auto make_small_lambda(const int offset) {
+  return [offset](const int value) { return value + offset; };
+}
+
+auto make_large_lambda(const int offset) {
+  return [capture = Capture{offset}](const int value) {
+    return value + capture.front();
+  };
+}
+
+template <typename Callable>
+auto call_repeatedly(Callable &callable) -> int {
+  auto result = 0;
+  for (auto index = 0; index < num_calls; ++index) {
+    result = callable(result);
+  }
+  return result;
+}
+}  // namespace
+
+TEST_CASE("Function construction", "[function][benchmark]") {
+  BENCHMARK("std::function, small capture") {
+    return std::function<int(int)>{make_small_lambda(1)};
+  };
+  BENCHMARK("gte::Function, small capture") {
+    return gte::Function<int(int)>{make_small_lambda(1)};
+  };
+  BENCHMARK("std::function, large capture") {
+    return std::function<int(int)>{make_large_lambda(1)};
+  };
+  BENCHMARK("gte::Function, large capture, heap") {
+    return gte::Function<int(int)>{make_large_lambda(1)};
+  };
+  BENCHMARK("gte::Function, large capture, inline") {
+    return gte::Function<int(int), sizeof(Capture)>{make_large_lambda(1)};
+  };
+  BENCHMARK("gte::FunctionRef, large capture") {
+    const auto lambda = make_large_lambda(1);
+    const auto function = gte::FunctionRef<int(int)>{lambda};
+    return function(0);
+  };
+}
+
+TEST_CASE("Function invocation", "[function][benchmark]") {
+  auto std_function = std::function<int(int)>{make_large_lambda(1)};
+  auto heap_function = gte::Function<int(int)>{make_large_lambda(1)};
+  auto inline_function =
+      gte::Function<int(int), sizeof(Capture)>{make_large_lambda(1)};
+  const auto lambda = make_large_lambda(1);
+  auto function_ref = gte::FunctionRef<int(int)>{lambda};
+
+  BENCHMARK("std::function") { return call_repeatedly(std_function); };
+  BENCHMARK("gte::Function, heap") { return call_repeatedly(heap_function); };
+  BENCHMARK("gte::Function, inline") {
+    return call_repeatedly(inline_function);
+  };
+  BENCHMARK("gte::FunctionRef") { return call_repeatedly(function_ref); };
+}
@@ -0,0 +1,143 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "generic-type-erasure.hpp"
+#include "slot-map.hpp"
+
+namespace {
+struct Weight {};
+using WeightFunction = gte::ConstMemberSignature<Weight, int()>;
+struct Feed {};
+using FeedFunction = gte::MemberSignature<Feed, void(int)>;
+using Pets = gte::ErasedSlotMap<WeightFunction, FeedFunction>;
+using Pet = Pets::Wrapper;
+
+struct Cat {
+  int m_weight = 10;
+
+  auto weight() const -> int { return m_weight; }
+  void feed(const int amount) { m_weight += amount; }
+};
+
+constexpr auto num_pets = std::size_t{10000};
+constexpr auto num_churns = 1000;
+constexpr auto calls_per_churn = 4;
+
+// Deterministic pseudo-random positions, so both stores see the same work.
+class Positions {
+ public:
+  auto next(const std::size_t size) -> std::size_t {
+    m_state = m_state * 6364136223846793005u + 1442695040888963407u;
+    return static_cast<std::size_t>(m_state >> 33) % size;
+  }
+
+ private:
+  std::uint64_t m_state = 42;
+};
+
+// The baseline: a vector of wrappers with swap-remove, and an id to index
+// map that is updated whenever an object moves.
+class VectorStore {
+ public:
+  auto insert(Pet pet) -> std::uint64_t {
+    const auto id = m_next_id++;
+    m_index_by_id.emplace(id, m_pets.size());
+    m_pets.push_back(std::move(pet));
+    m_ids.push_back(id);
+    return id;
+  }
+
+  void erase(const std::uint64_t id) {
+    const auto entry = m_index_by_id.find(id);
+    const auto index = entry->second;
+    m_index_by_id.erase(entry);
+    if (index != m_pets.size() - 1) {
+      m_pets[index] = std::move(m_pets.back());
+      m_ids[index] = m_ids.back();
+      m_index_by_id[m_ids[index]] = index;
+    }
+    m_pets.pop_back();
+    m_ids.pop_back();
+  }
+
+  auto at(const std::uint64_t id) -> Pet & {
+    return m_pets[m_index_by_id.at(id)];
+  }
+
+  auto total_weight() const -> int {
+    auto total = 0;
+    for (const auto &pet : m_pets) {
+      total += pet.call<Weight>();
+    }
+    return total;
+  }
+
+ private:
+  std::vector<Pet> m_pets;
+  std::vector<std::uint64_t> m_ids;
+  std::unordered_map<std::uint64_t, std::size_t> m_index_by_id;
+  std::uint64_t m_next_id = 0;
+};
+
+auto make_pet() -> Pet { return Pet{Cat{}, &Cat::weight, &Cat::feed}; }
+
+// Erases and inserts a pet, then feeds a few pets by id, num_churns times.
+template <typename Store, typename Key>
+auto churn(Store &store, std::vector<Key> &keys) -> int {
+  auto positions = Positions{};
+  for (auto round = 0; round < num_churns; ++round) {
+    auto &key = keys[positions.next(keys.size())];
+    store.erase(key);
+    key = store.insert(make_pet());
+    for (auto call = 0; call < calls_per_churn; ++call) {
+      store.at(keys[positions.next(keys.size())]).template call<Feed>(1);
+    }
+  }
+  return store.total_weight();
+}
+
+auto total_weight(const Pets &pets) -> int {
+  auto total = 0;
+  for (const auto &pet : pets) {
+    total += pet.call<Weight>();
+  }
+  return total;
+}
+
+// Adapts ErasedSlotMap to the interface used by churn.
+struct SlotMapStore {
+  Pets pets;
+
+  auto insert(Pet pet) -> gte::SlotHandle {
+    return pets.insert(std::move(pet));
+  }
+  void erase(const gte::SlotHandle handle) { pets.erase(handle); }
+  auto at(const gte::SlotHandle handle) -> Pet & { return pets.at(handle); }
+  auto total_weight() const -> int { return ::total_weight(pets); }
+};
+}  // namespace
+
+TEST_CASE("Slot map churn", "[slot_map][benchmark]") {
+  BENCHMARK_ADVANCED("std::vector and std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    auto store = VectorStore{};
+    auto keys = std::vector<std::uint64_t>{};
+    for (auto index = std::size_t{0}; index < num_pets; ++index) {
+      keys.push_back(store.insert(make_pet()));
+    }
+    meter.measure([&] { return churn(store, keys); });
+  };
+  BENCHMARK_ADVANCED("gte::ErasedSlotMap")
+  (Catch::Benchmark::Chronometer meter) {
+    auto store = SlotMapStore{};
+    auto keys = std::vector<gte::SlotHandle>{};
+    for (auto index = std::size_t{0}; index < num_pets; ++index) {
+      keys.push_back(store.insert(make_pet()));
+    }
+    meter.measure([&] { return churn(store, keys); });
+  };
+}
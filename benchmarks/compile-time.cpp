@@ -0,0 +1,43 @@
+// Instantiates and calls a wrapper with GTE_NUM_TAGS tags. Built once per tag
+// count by the compile_time_benchmarks target, which reports compile times.
+#include <cstddef>
+#include <utility>
+
+#include "generic-type-erasure.hpp"
+
+#ifndef GTE_NUM_TAGS
+#define GTE_NUM_TAGS 8
+#endif
+
+namespace {
+template <std::size_t I>
+struct Tag {};
+
+struct Object {
+  template <std::size_t I>
+  auto get() const -> std::size_t {
+    return I + value;
+  }
+
+  std::size_t value = 0;
+};
+
+template <std::size_t... Indices>
+auto make_wrapper(std::index_sequence<Indices...>) {
+  using Wrapper = gte::TypeErased<
+      gte::ConstMemberSignature<Tag<Indices>, std::size_t()>...>;
+  return Wrapper{Object{}, &Object::get<Indices>...};
+}
+
+template <typename Wrapper, std::size_t... Indices>
+auto call_all(const Wrapper &wrapper, std::index_sequence<Indices...>)
+    -> std::size_t {
+  return (wrapper.template call<Tag<Indices>>() + ...);
+}
+}  // namespace
+
+auto compile_time_benchmark() -> std::size_t {
+  constexpr auto indices = std::make_index_sequence<GTE_NUM_TAGS>();
+  const auto wrapper = make_wrapper(indices);
+  return call_all(wrapper, indices);
+}
@@ -0,0 +1,289 @@
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "generic-type-erasure.hpp"
+#include "type-helpers.hpp"
+#include "type-map.hpp"
+
+namespace gte {
+constexpr auto default_command_block_bytes = std::size_t{64 * 1024};
+
+enum class ReplayOrder {
+  recorded,   // In the order the commands were recorded
+  by_object,  // Grouped by object, in recorded order for each object
+  by_type     // Grouped by concrete type, in recorded order for each type
+};
+
+namespace detail {
+[[nodiscard]] constexpr auto align_up(const std::size_t offset,
+                                      const std::size_t alignment)
+    -> std::size_t {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Every command is a header followed by its arguments, stored contiguously in
+// the command buffer's blocks. Blocks are allocated with new[] and command
+// sizes are multiples of command_alignment, so every command starts aligned
+// for its header and for arguments of any fundamental alignment.
+constexpr auto command_alignment = alignof(std::max_align_t);
+
+template <typename Wrapper>
+struct CommandHeader {
+  Wrapper *object;
+  void (*replay)(Wrapper &, void *command);
+  void (*destroy)(void *command) noexcept;
+  std::size_t size;
+};
+
+// Arguments are stored as the decayed parameter types of the tag, so
+// conversions such as const char * to const std::string & happen when the
+// command is recorded. std::ref and std::cref arguments are stored as
+// references.
+template <typename Parameter, typename Argument>
+struct StoredArgument {
+  using Type = std::decay_t<Parameter>;
+};
+
+template <typename Parameter, typename T>
+struct StoredArgument<Parameter, std::reference_wrapper<T> > {
+  using Type = T &;
+};
+
+template <typename ParameterTuple, typename ArgumentTuple>
+struct StoredArguments;
+
+template <typename... Parameters, typename... Arguments>
+struct StoredArguments<std::tuple<Parameters...>, std::tuple<Arguments...> > {
+  static_assert(sizeof...(Parameters) == sizeof...(Arguments),
+                "The number of arguments must match the tag signature.");
+  using Type =
+      std::tuple<typename StoredArgument<Parameters, Arguments>::Type...>;
+};
+
+template <typename CallTag, typename... MemberSignatureTypes>
+using TagParameters = typename SignatureHelper<std::tuple_element_t<
+    UniqueIndex<CallTag,
+                std::tuple<typename MemberSignatureTypes::Tag...> >::value,
+    std::tuple<typename MemberSignatureTypes::Signature...> > >::ArgTypes;
+
+template <typename CallTag, typename Wrapper, typename ParameterTuple,
+          typename ArgTuple>
+struct Command;
+
+template <typename CallTag, typename Wrapper, typename... Parameters,
+          typename ArgTuple>
+struct Command<CallTag, Wrapper, std::tuple<Parameters...>, ArgTuple> {
+  using Header = CommandHeader<Wrapper>;
+
+  static constexpr auto arguments_offset =
+      align_up(sizeof(Header), alignof(ArgTuple));
+  static constexpr auto size =
+      align_up(arguments_offset + sizeof(ArgTuple), command_alignment);
+
+  static auto arguments_storage(void *command) -> void * {
+    return static_cast<std::byte *>(command) + arguments_offset;
+  }
+
+  static auto arguments(void *command) -> ArgTuple * {
+    return std::launder(static_cast<ArgTuple *>(arguments_storage(command)));
+  }
+
+  static void replay(Wrapper &object, void *command) {
+    replay(object, *arguments(command),
+           std::index_sequence_for<Parameters...>{});
+  }
+
+  template <std::size_t... Indices>
+  static void replay(Wrapper &object, ArgTuple &args,
+                     std::index_sequence<Indices...>) {
+    object.template call<CallTag>(
+        static_cast<std::conditional_t<
+            std::is_lvalue_reference_v<Parameters>,
+            std::tuple_element_t<Indices, ArgTuple> &,
+            std::tuple_element_t<Indices, ArgTuple> &&> >(
+            std::get<Indices>(args))...);
+  }
+
+  static void destroy(void *command) noexcept {
+    arguments(command)->~ArgTuple();
+  }
+};
+}  // namespace detail
+
+// Records non-const tag calls on TypeErased objects and replays them later
+// through TypeErased::call. Commands are stored in reusable blocks, so
+// recording does not allocate once the blocks have grown to the workload. A
+// CommandBuffer is not thread-safe: give each producer thread its own buffer
+// and apply the buffers on the thread that owns the objects. The buffer is
+// parameterized on the wrapper type, e.g. gte::CommandBuffer<Pet>.
+template <typename Wrapper>
+class CommandBuffer;
+
+template <typename... MemberSignatureTypes>
+class CommandBuffer<TypeErased<MemberSignatureTypes...> > {
+ public:
+  using Wrapper = TypeErased<MemberSignatureTypes...>;
+
+  explicit CommandBuffer(
+      const std::size_t block_bytes = default_command_block_bytes)
+      : m_block_bytes{block_bytes} {}
+
+  CommandBuffer(const CommandBuffer &) = delete;
+  auto operator=(const CommandBuffer &) -> CommandBuffer & = delete;
+
+  CommandBuffer(CommandBuffer &&other) noexcept
+      : m_block_bytes{other.m_block_bytes},
+        m_blocks{std::move(other.m_blocks)},
+        m_num_active_blocks{std::exchange(other.m_num_active_blocks, 0)},
+        m_size{std::exchange(other.m_size, 0)} {}
+
+  auto operator=(CommandBuffer &&other) noexcept -> CommandBuffer & {
+    if (this != &other) {
+      clear();
+      m_block_bytes = other.m_block_bytes;
+      m_blocks = std::move(other.m_blocks);
+      m_num_active_blocks = std::exchange(other.m_num_active_blocks, 0);
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  ~CommandBuffer() { clear(); }
+
+  // Stores copies of args; use std::ref or std::cref to pass by reference.
+  // object must outlive the next call to apply.
+  template <typename CallTag, typename... Args>
+  void record(Wrapper &object, Args &&...args) {
+    static_assert(
+        detail::UniqueIndex<
+            CallTag, std::tuple<typename MemberSignatureTypes::Tag...> >::found,
+        "The tag must appear exactly once.");
+    using Parameters =
+        detail::TagParameters<CallTag, MemberSignatureTypes...>;
+    using ArgTuple = typename detail::StoredArguments<
+        Parameters, std::tuple<std::decay_t<Args>...> >::Type;
+    using Command = detail::Command<CallTag, Wrapper, Parameters, ArgTuple>;
+    static_assert(alignof(ArgTuple) <= alignof(std::max_align_t),
+                  "Over-aligned command arguments are not supported.");
+
+    auto *command = reserve(Command::size);
+    ::new (Command::arguments_storage(command))
+        ArgTuple(std::forward<Args>(args)...);
+    ::new (command) Header{&object, &Command::replay, &Command::destroy,
+                           Command::size};
+    m_blocks[m_num_active_blocks - 1].used += Command::size;
+    ++m_size;
+  }
+
+  // Replays and then discards all commands. If a call throws, the remaining
+  // commands are discarded without being replayed.
+  void apply(const ReplayOrder order = ReplayOrder::recorded) {
+    const auto clear_on_exit = ClearOnExit{*this};
+    if (order == ReplayOrder::recorded) {
+      for_each_command([](Header &header) {
+        header.replay(*header.object, &header);
+      });
+      return;
+    }
+
+    m_order.clear();
+    for_each_command([this](Header &header) { m_order.push_back(&header); });
+    if (order == ReplayOrder::by_object) {
+      std::stable_sort(m_order.begin(), m_order.end(),
+                       [](const Header *lhs, const Header *rhs) {
+                         return std::less<>{}(lhs->object, rhs->object);
+                       });
+    } else {
+      std::stable_sort(m_order.begin(), m_order.end(),
+                       [](const Header *lhs, const Header *rhs) {
+                         return std::type_index{lhs->object->target_type()} <
+                                std::type_index{rhs->object->target_type()};
+                       });
+    }
+    for (auto *header : m_order) {
+      header->replay(*header->object, header);
+    }
+  }
+
+  // Discards all commands without replaying them. Blocks are kept for reuse.
+  void clear() noexcept {
+    for_each_command([](Header &header) { header.destroy(&header); });
+    for (auto &block : m_blocks) {
+      block.used = 0;
+    }
+    m_num_active_blocks = 0;
+    m_size = 0;
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t { return m_size; }
+  [[nodiscard]] auto empty() const -> bool { return m_size == 0; }
+
+ private:
+  using Header = detail::CommandHeader<Wrapper>;
+
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    std::size_t capacity;
+    std::size_t used;
+  };
+
+  struct ClearOnExit {
+    ~ClearOnExit() { buffer.clear(); }
+    CommandBuffer &buffer;
+  };
+
+  // Returns storage for a command of size bytes at the end of the last active
+  // block, moving on to a reused or new block if it does not fit.
+  auto reserve(const std::size_t size) -> std::byte * {
+    if (m_num_active_blocks == 0 ||
+        m_blocks[m_num_active_blocks - 1].capacity -
+                m_blocks[m_num_active_blocks - 1].used <
+            size) {
+      if (m_num_active_blocks == m_blocks.size() ||
+          m_blocks[m_num_active_blocks].capacity < size) {
+        const auto capacity = std::max(size, m_block_bytes);
+        m_blocks.insert(
+            m_blocks.begin() +
+                static_cast<std::ptrdiff_t>(m_num_active_blocks),
+            Block{std::unique_ptr<std::byte[]>{new std::byte[capacity]},
+                  capacity, 0});
+      }
+      ++m_num_active_blocks;
+    }
+    auto &block = m_blocks[m_num_active_blocks - 1];
+    return block.data.get() + block.used;
+  }
+
+  template <typename F>
+  void for_each_command(F &&f) {
+    for (auto index = std::size_t{0}; index < m_num_active_blocks; ++index) {
+      auto &block = m_blocks[index];
+      for (auto offset = std::size_t{0}; offset < block.used;) {
+        auto &header = *std::launder(
+            reinterpret_cast<Header *>(block.data.get() + offset));
+        offset += header.size;
+        f(header);
+      }
+    }
+  }
+
+  std::size_t m_block_bytes;
+  std::vector<Block> m_blocks;
+  std::size_t m_num_active_blocks = 0;
+  std::size_t m_size = 0;
+  std::vector<Header *> m_order;
+};
+}  // namespace gte
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef EXECUTORS_HPP
+#define EXECUTORS_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "function.hpp"
+
+namespace gte {
+// Runs tasks immediately on the calling thread.
+struct InlineExecutor {
+  template <typename Task>
+  void execute(Task &&task) {
+    std::forward<Task>(task)();
+  }
+};
+
+constexpr auto thread_pool_task_inline_bytes = 8 * sizeof(void *);
+
+// Fixed-size pool of worker threads running tasks in submission order. Queued
+// tasks are finished before the pool is destroyed.
+class ThreadPool {
+ public:
+  using Task = Function<void(), thread_pool_task_inline_bytes>;
+
+  explicit ThreadPool(const std::size_t num_threads = default_num_threads()) {
+    m_threads.reserve(num_threads);
+    for (auto index = std::size_t{0}; index < num_threads; ++index) {
+      m_threads.emplace_back([this] { work(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+  ~ThreadPool() {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto &thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  void execute(Task task) {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+  }
+
+  [[nodiscard]] auto num_threads() const -> std::size_t {
+    return m_threads.size();
+  }
+
+  [[nodiscard]] static auto default_num_threads() -> std::size_t {
+    const auto hardware_threads =
+        static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return std::max(std::size_t{1}, hardware_threads);
+  }
+
+ private:
+  void work() {
+    while (true) {
+      auto lock = std::unique_lock{m_mutex};
+      m_condition.wait(lock,
+                       [this] { return m_stopping || !m_tasks.empty(); });
+      if (m_tasks.empty()) {
+        return;
+      }
+      auto task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      lock.unlock();
+      task();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<Task> m_tasks;
+  bool m_stopping = false;
+  std::vector<std::thread> m_threads;
+};
+}  // namespace gte
+
+#endif
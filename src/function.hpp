@@ -0,0 +1,341 @@
+#ifndef FUNCTION_HPP
+#define FUNCTION_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "type-helpers.hpp"
+
+namespace gte {
+constexpr auto default_function_inline_bytes = 3 * sizeof(void *);
+
+namespace detail {
+template <typename R, typename F, typename... Args>
+constexpr auto invoke_r(F &&f, Args &&...args) -> R {
+  if constexpr (std::is_void_v<R>) {
+    std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+  } else {
+    return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+  }
+}
+
+template <typename Callable, bool IsConst>
+using InvokedAs =
+    std::conditional_t<IsConst, const Callable &, Callable &>;
+
+template <typename Callable, bool IsConst, bool IsNoexcept, typename R,
+          typename... Args>
+[[nodiscard]] constexpr auto is_compatible_callable() -> bool {
+  if constexpr (IsNoexcept) {
+    return std::is_nothrow_invocable_r_v<R, InvokedAs<Callable, IsConst>,
+                                         Args...>;
+  } else {
+    return std::is_invocable_r_v<R, InvokedAs<Callable, IsConst>, Args...>;
+  }
+}
+
+template <typename Callable, std::size_t InlineBytes>
+[[nodiscard]] constexpr auto fits_inline() -> bool {
+  return sizeof(Callable) <= InlineBytes &&
+         alignof(Callable) <= alignof(std::max_align_t) &&
+         std::is_nothrow_move_constructible_v<Callable>;
+}
+
+template <bool IsNoexcept, typename R, typename... Args>
+struct FunctionVTable {
+  using Invoke = R (*)(void *, Args &&...) noexcept(IsNoexcept);
+  using Relocate = void (*)(void *from, void *to) noexcept;
+  using Destroy = void (*)(void *) noexcept;
+
+  Invoke invoke;
+  Relocate relocate;
+  Destroy destroy;
+};
+
+// Callables that fit the inline buffer are constructed in it, larger ones are
+// allocated and the buffer holds the owning pointer.
+template <typename Callable, bool Inline>
+struct FunctionStorageManager {
+  static auto object(void *storage) noexcept -> Callable * {
+    return std::launder(static_cast<Callable *>(storage));
+  }
+
+  template <typename F>
+  static void emplace(void *storage, F &&f) {
+    ::new (storage) Callable(std::forward<F>(f));
+  }
+
+  static void relocate(void *from, void *to) noexcept {
+    ::new (to) Callable(std::move(*object(from)));
+    object(from)->~Callable();
+  }
+
+  static void destroy(void *storage) noexcept { object(storage)->~Callable(); }
+};
+
+template <typename Callable>
+struct FunctionStorageManager<Callable, false> {
+  static auto object(void *storage) noexcept -> Callable * {
+    return *std::launder(static_cast<Callable **>(storage));
+  }
+
+  template <typename F>
+  static void emplace(void *storage, F &&f) {
+    ::new (storage) Callable *(new Callable(std::forward<F>(f)));
+  }
+
+  static void relocate(void *from, void *to) noexcept {
+    ::new (to) Callable *(object(from));
+  }
+
+  static void destroy(void *storage) noexcept { delete object(storage); }
+};
+
+template <typename Callable, std::size_t InlineBytes, bool IsConst,
+          bool IsNoexcept, typename R, typename... Args>
+struct FunctionVTableFor {
+  using Manager =
+      FunctionStorageManager<Callable, fits_inline<Callable, InlineBytes>()>;
+
+  static auto invoke(void *storage, Args &&...args) noexcept(IsNoexcept)
+      -> R {
+    return invoke_r<R>(
+        static_cast<InvokedAs<Callable, IsConst>>(*Manager::object(storage)),
+        std::forward<Args>(args)...);
+  }
+
+  static constexpr auto vtable = FunctionVTable<IsNoexcept, R, Args...>{
+      &invoke, &Manager::relocate, &Manager::destroy};
+};
+
+template <std::size_t InlineBytes, bool IsConst, bool IsNoexcept, typename R,
+          typename ArgTuple>
+class FunctionImpl;
+
+template <std::size_t InlineBytes, bool IsConst, bool IsNoexcept, typename R,
+          typename... Args>
+class FunctionImpl<InlineBytes, IsConst, IsNoexcept, R, std::tuple<Args...>> {
+ public:
+  template <typename Callable>
+  static constexpr bool stores_inline =
+      fits_inline<std::decay_t<Callable>, InlineBytes>();
+
+  FunctionImpl() noexcept = default;
+  FunctionImpl(std::nullptr_t) noexcept {}
+
+  template <typename F, typename Callable = std::decay_t<F>,
+            std::enable_if_t<!std::is_base_of_v<FunctionImpl, Callable> &&
+                                 is_compatible_callable<Callable, IsConst,
+                                                        IsNoexcept, R,
+                                                        Args...>(),
+                             bool> = true>
+  FunctionImpl(F &&f) {
+    if constexpr (std::is_pointer_v<Callable> ||
+                  std::is_member_pointer_v<Callable>) {
+      if (f == nullptr) {
+        return;
+      }
+    }
+    using VTableFor = FunctionVTableFor<Callable, InlineBytes, IsConst,
+                                        IsNoexcept, R, Args...>;
+    VTableFor::Manager::emplace(m_storage, std::forward<F>(f));
+    m_vtable = &VTableFor::vtable;
+  }
+
+  FunctionImpl(const FunctionImpl &) = delete;
+  auto operator=(const FunctionImpl &) -> FunctionImpl & = delete;
+
+  FunctionImpl(FunctionImpl &&other) noexcept { take(other); }
+
+  auto operator=(FunctionImpl &&other) noexcept -> FunctionImpl & {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  auto operator=(std::nullptr_t) noexcept -> FunctionImpl & {
+    reset();
+    return *this;
+  }
+
+  ~FunctionImpl() { reset(); }
+
+  explicit operator bool() const noexcept { return m_vtable != nullptr; }
+
+ protected:
+  auto invoke(Args &&...args) const noexcept(IsNoexcept) -> R {
+    assert(m_vtable != nullptr && "Called an empty gte::Function.");
+    // Const signatures only ever access the callable as const.
+    return m_vtable->invoke(const_cast<std::byte *>(m_storage),
+                            std::forward<Args>(args)...);
+  }
+
+ private:
+  static constexpr auto storage_bytes =
+      InlineBytes < sizeof(void *) ? sizeof(void *) : InlineBytes;
+
+  void take(FunctionImpl &other) noexcept {
+    if (other.m_vtable != nullptr) {
+      other.m_vtable->relocate(other.m_storage, m_storage);
+      m_vtable = std::exchange(other.m_vtable, nullptr);
+    }
+  }
+
+  void reset() noexcept {
+    if (m_vtable != nullptr) {
+      m_vtable->destroy(m_storage);
+      m_vtable = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) std::byte m_storage[storage_bytes];
+  const FunctionVTable<IsNoexcept, R, Args...> *m_vtable = nullptr;
+};
+
+template <typename Signature, std::size_t InlineBytes>
+using FunctionBase =
+    FunctionImpl<InlineBytes, SignatureHelper<Signature>::is_const,
+                 SignatureHelper<Signature>::is_noexcept,
+                 typename SignatureHelper<Signature>::ReturnType,
+                 typename SignatureHelper<Signature>::ArgTypes>;
+
+template <bool IsConst, bool IsNoexcept, typename R, typename ArgTuple>
+class FunctionRefImpl;
+
+template <bool IsConst, bool IsNoexcept, typename R, typename... Args>
+class FunctionRefImpl<IsConst, IsNoexcept, R, std::tuple<Args...>> {
+ public:
+  template <typename F, typename Callable = std::remove_reference_t<F>,
+            std::enable_if_t<
+                !std::is_base_of_v<FunctionRefImpl,
+                                   std::remove_cv_t<Callable>> &&
+                    is_compatible_callable<Callable, IsConst, IsNoexcept, R,
+                                           Args...>(),
+                bool> = true>
+  FunctionRefImpl(F &&f) noexcept {
+    if constexpr (std::is_function_v<Callable>) {
+      bind_function(&f);
+    } else if constexpr (std::is_pointer_v<Callable> &&
+                         std::is_function_v<std::remove_pointer_t<Callable>>) {
+      assert(f != nullptr && "Bound a null function pointer.");
+      bind_function(f);
+    } else {
+      m_object.pointer =
+          const_cast<void *>(static_cast<const void *>(std::addressof(f)));
+      m_invoke = [](Object object,
+                    Args &&...args) noexcept(IsNoexcept) -> R {
+        auto &callable = *static_cast<Callable *>(object.pointer);
+        return invoke_r<R>(static_cast<InvokedAs<Callable, IsConst>>(callable),
+                           std::forward<Args>(args)...);
+      };
+    }
+  }
+
+  auto operator()(Args... args) const noexcept(IsNoexcept) -> R {
+    return m_invoke(m_object, std::forward<Args>(args)...);
+  }
+
+ private:
+  union Object {
+    void *pointer;
+    void (*function)();
+  };
+
+  template <typename FunctionType>
+  void bind_function(FunctionType *function) noexcept {
+    m_object.function = reinterpret_cast<void (*)()>(function);
+    m_invoke = [](Object object, Args &&...args) noexcept(IsNoexcept) -> R {
+      return invoke_r<R>(reinterpret_cast<FunctionType *>(object.function),
+                         std::forward<Args>(args)...);
+    };
+  }
+
+  Object m_object;
+  R (*m_invoke)(Object, Args &&...) noexcept(IsNoexcept);
+};
+
+template <typename Signature>
+using FunctionRefBase =
+    FunctionRefImpl<SignatureHelper<Signature>::is_const,
+                    SignatureHelper<Signature>::is_noexcept,
+                    typename SignatureHelper<Signature>::ReturnType,
+                    typename SignatureHelper<Signature>::ArgTypes>;
+}  // namespace detail
+
+// Owning, move-only callable wrapper. Callables of at most InlineBytes (and
+// nothrow movable) are stored inline; anything larger is heap allocated.
+template <typename Signature,
+          std::size_t InlineBytes = default_function_inline_bytes>
+class Function;
+
+template <typename R, typename... Args, std::size_t InlineBytes>
+class Function<R(Args...), InlineBytes>
+    : public detail::FunctionBase<R(Args...), InlineBytes> {
+  using Base = detail::FunctionBase<R(Args...), InlineBytes>;
+
+ public:
+  using Base::Base;
+
+  auto operator()(Args... args) -> R {
+    return this->invoke(std::forward<Args>(args)...);
+  }
+};
+
+template <typename R, typename... Args, std::size_t InlineBytes>
+class Function<R(Args...) const, InlineBytes>
+    : public detail::FunctionBase<R(Args...) const, InlineBytes> {
+  using Base = detail::FunctionBase<R(Args...) const, InlineBytes>;
+
+ public:
+  using Base::Base;
+
+  auto operator()(Args... args) const -> R {
+    return this->invoke(std::forward<Args>(args)...);
+  }
+};
+
+template <typename R, typename... Args, std::size_t InlineBytes>
+class Function<R(Args...) noexcept, InlineBytes>
+    : public detail::FunctionBase<R(Args...) noexcept, InlineBytes> {
+  using Base = detail::FunctionBase<R(Args...) noexcept, InlineBytes>;
+
+ public:
+  using Base::Base;
+
+  auto operator()(Args... args) noexcept -> R {
+    return this->invoke(std::forward<Args>(args)...);
+  }
+};
+
+template <typename R, typename... Args, std::size_t InlineBytes>
+class Function<R(Args...) const noexcept, InlineBytes>
+    : public detail::FunctionBase<R(Args...) const noexcept, InlineBytes> {
+  using Base = detail::FunctionBase<R(Args...) const noexcept, InlineBytes>;
+
+ public:
+  using Base::Base;
+
+  auto operator()(Args... args) const noexcept -> R {
+    return this->invoke(std::forward<Args>(args)...);
+  }
+};
+
+// Non-owning reference to a callable. The referenced callable must outlive
+// the FunctionRef.
+template <typename Signature>
+class FunctionRef : public detail::FunctionRefBase<Signature> {
+  using Base = detail::FunctionRefBase<Signature>;
+
+ public:
+  using Base::Base;
+};
+}  // namespace gte
+
+#endif
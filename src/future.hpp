@@ -0,0 +1,211 @@
+#ifndef FUTURE_HPP
+#define FUTURE_HPP
+
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace gte {
+namespace detail {
+struct VoidResult {};
+
+template <typename R>
+using AsyncResult = std::conditional_t<std::is_void_v<R>, VoidResult, R>;
+
+// State shared between a Future and the task computing its result.
+template <typename R>
+class AsyncState {
+ public:
+  template <typename F>
+  void run(F &f) noexcept {
+    try {
+      if constexpr (std::is_void_v<R>) {
+        f();
+        set(VoidResult{});
+      } else {
+        set(f());
+      }
+    } catch (...) {
+      set(std::current_exception());
+    }
+  }
+
+  // Completes the state with a broken_promise std::future_error, for tasks
+  // destroyed without being run.
+  void abandon() noexcept {
+    set(std::make_exception_ptr(
+        std::future_error{std::future_errc::broken_promise}));
+  }
+
+  [[nodiscard]] auto ready() const -> bool {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_ready;
+  }
+
+  void wait() const {
+    auto lock = std::unique_lock{m_mutex};
+    m_condition.wait(lock, [this] { return m_ready; });
+  }
+
+  auto get() -> R {
+    wait();
+    if (auto *exception = std::get_if<std::exception_ptr>(&m_result)) {
+      std::rethrow_exception(*exception);
+    }
+    if constexpr (!std::is_void_v<R>) {
+      return std::move(std::get<AsyncResult<R>>(m_result));
+    }
+  }
+
+ private:
+  template <typename Value>
+  void set(Value &&value) {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_result.template emplace<std::decay_t<Value>>(
+          std::forward<Value>(value));
+      m_ready = true;
+    }
+    m_condition.notify_all();
+  }
+
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_condition;
+  bool m_ready = false;
+  std::variant<std::monostate, AsyncResult<R>, std::exception_ptr> m_result;
+};
+
+// Calls CallTag on an erased object with arguments stored by value.
+template <typename CallTag, typename Object, typename ArgTuple>
+struct AsyncCall {
+  auto operator()() {
+    return std::apply(
+        [this](auto &&...args) {
+          return object->template call<CallTag>(
+              std::forward<decltype(args)>(args)...);
+        },
+        std::move(arguments));
+  }
+
+  Object *object;
+  ArgTuple arguments;
+};
+
+// The task handed to the executor. It is move-only, and abandons the shared
+// state if it is destroyed without being run, so that a Future whose task was
+// dropped by its executor does not wait forever.
+template <typename R, typename Call>
+class AsyncTask {
+ public:
+  AsyncTask(std::shared_ptr<AsyncState<R>> state, Call call)
+      : m_state{std::move(state)}, m_call{std::move(call)} {}
+
+  AsyncTask(AsyncTask &&) = default;
+  AsyncTask(const AsyncTask &) = delete;
+  auto operator=(const AsyncTask &) -> AsyncTask & = delete;
+
+  ~AsyncTask() {
+    if (m_state != nullptr) {
+      m_state->abandon();
+    }
+  }
+
+  void operator()() {
+    const auto state = std::move(m_state);
+    state->run(m_call);
+  }
+
+ private:
+  std::shared_ptr<AsyncState<R>> m_state;
+  Call m_call;
+};
+
+template <typename CallTag, typename Object, typename ArgTuple>
+using AsyncCallResult =
+    decltype(std::declval<AsyncCall<CallTag, Object, ArgTuple> &>()());
+}  // namespace detail
+
+// Result of an asynchronous call. A Future is move-only and get() may be
+// called once.
+template <typename R>
+class Future {
+ public:
+  Future() = default;
+  explicit Future(std::shared_ptr<detail::AsyncState<R>> state)
+      : m_state{std::move(state)} {}
+
+  [[nodiscard]] auto valid() const -> bool { return m_state != nullptr; }
+
+  [[nodiscard]] auto ready() const -> bool {
+    assert(valid() && "Used an invalid gte::Future.");
+    return m_state->ready();
+  }
+
+  void wait() const {
+    assert(valid() && "Used an invalid gte::Future.");
+    m_state->wait();
+  }
+
+  auto get() -> R {
+    assert(valid() && "Used an invalid gte::Future.");
+    const auto state = std::move(m_state);
+    return state->get();
+  }
+
+ private:
+  std::shared_ptr<detail::AsyncState<R>> m_state;
+};
+
+namespace detail {
+template <typename CallTag, typename Allocator, typename Wrapper,
+          typename Executor, typename... Args>
+auto call_async(const Allocator &allocator, Wrapper &wrapper,
+                Executor &executor, Args &&...args) {
+  using ArgTuple = decltype(std::make_tuple(std::forward<Args>(args)...));
+  using Call = AsyncCall<CallTag, Wrapper, ArgTuple>;
+  using Result = AsyncCallResult<CallTag, Wrapper, ArgTuple>;
+
+  auto state = std::allocate_shared<AsyncState<Result>>(allocator);
+  auto call = Call{&wrapper, std::make_tuple(std::forward<Args>(args)...)};
+  executor.execute(AsyncTask<Result, Call>{state, std::move(call)});
+  return Future<Result>{std::move(state)};
+}
+}  // namespace detail
+
+// Runs CallTag on executor with copies of args. The task refers to the
+// wrapper by address: the wrapper must outlive the call even if the future is
+// dropped, and must not be moved, e.g. by std::vector reallocation or
+// ErasedSlotMap::erase, until the call has run. Const tags may run
+// concurrently on the same object. If the executor destroys the task without
+// running it, get() throws std::future_error with broken_promise. The shared
+// state is the only allocation; the task is small enough to be stored inline
+// by executors using gte::Function unless the arguments are large.
+template <typename CallTag, typename Wrapper, typename Executor,
+          typename... Args,
+          std::enable_if_t<!std::is_same_v<std::remove_cv_t<Wrapper>,
+                                           std::allocator_arg_t>,
+                           bool> = true>
+auto call_async(Wrapper &wrapper, Executor &executor, Args &&...args) {
+  return detail::call_async<CallTag>(std::allocator<void>{}, wrapper,
+                                     executor, std::forward<Args>(args)...);
+}
+
+// Allocates the shared state with allocator, e.g. a pooled
+// std::pmr::polymorphic_allocator, so calls need not allocate from the heap.
+template <typename CallTag, typename Allocator, typename Wrapper,
+          typename Executor, typename... Args>
+auto call_async(std::allocator_arg_t, const Allocator &allocator,
+                Wrapper &wrapper, Executor &executor, Args &&...args) {
+  return detail::call_async<CallTag>(allocator, wrapper, executor,
+                                     std::forward<Args>(args)...);
+}
+}  // namespace gte
+
+#endif
@@ -3,39 +3,133 @@
 #include <type_traits>
 #include <variant>
 
+#include "member.hpp"
 #include "type-helpers.hpp"
 #include "type-map.hpp"
 
 namespace gte {
 namespace detail {
-template <typename T, typename MemberFunction, typename Signature>
+// Bindings that are empty and default constructible are recreated on each
+// call instead of being stored.
+template <typename Binding>
+inline constexpr bool is_stored_binding =
+    !(std::is_empty_v<Binding> && std::is_default_constructible_v<Binding>);
+
+// Tags are bound to member function pointers, data member pointers or
+// callables taking the object as their first parameter. Bindings are stored in
+// the wrapper's std::any, except for compile-time gte::member bindings and
+// empty, default constructible callables, which are called directly. Lambdas
+// are only default constructible from C++20, so in C++17 every lambda binding
+// is stored.
+//
+// Pointer bindings are called on a const object if they can be. Callable
+// objects are only probed with a const object for const tags: probing a
+// generic lambda instantiates its body, which is a hard error if the body
+// modifies the object.
+template <typename Binding, typename BaseType, typename ArgTuple,
+          bool IsConstTag>
+struct BindingHelper;
+
+template <typename Binding, typename BaseType, typename... Args,
+          bool IsConstTag>
+struct BindingHelper<Binding, BaseType, std::tuple<Args...>, IsConstTag> {
+  static constexpr auto is_const = std::conjunction_v<
+      std::bool_constant<IsConstTag || !std::is_class_v<Binding> >,
+      std::is_invocable<const Binding &, const BaseType &, Args...> >;
+  using Object = std::conditional_t<is_const, const BaseType, BaseType>;
+  static constexpr auto is_invocable =
+      std::is_invocable_v<const Binding &, Object &, Args...>;
+  static constexpr auto is_noexcept =
+      std::is_nothrow_invocable_v<const Binding &, Object &, Args...>;
+  static constexpr auto is_stored = is_stored_binding<Binding>;
+
+  static auto invoke(const std::any &binding, Object &object,
+                     std::tuple<Args...> &&args) -> decltype(auto) {
+    auto object_and_args =
+        std::tuple_cat(std::tuple<Object &>{object}, std::move(args));
+    if constexpr (is_stored) {
+      return std::apply(std::any_cast<const Binding &>(binding),
+                        std::move(object_and_args));
+    } else {
+      return std::apply(Binding{}, std::move(object_and_args));
+    }
+  }
+};
+
+template <auto MemberPointer, typename BaseType, typename... Args,
+          bool IsConstTag>
+struct BindingHelper<Member<MemberPointer>, BaseType, std::tuple<Args...>,
+                     IsConstTag>
+    : BindingHelper<decltype(MemberPointer), BaseType, std::tuple<Args...>,
+                    IsConstTag> {
+  using Object =
+      typename BindingHelper<decltype(MemberPointer), BaseType,
+                             std::tuple<Args...>, IsConstTag>::Object;
+  static constexpr auto is_stored = false;
+
+  static constexpr auto invoke(Object &object, std::tuple<Args...> &&args)
+      -> decltype(auto) {
+    return std::apply(MemberPointer,
+                      std::tuple_cat(std::tuple<Object &>{object},
+                                     std::move(args)));
+  }
+
+  static constexpr auto invoke(const std::any &, Object &object,
+                               std::tuple<Args...> &&args) -> decltype(auto) {
+    return invoke(object, std::move(args));
+  }
+};
+
+template <typename Binding>
+struct BoundPointer {
+  using Type = Binding;
+};
+
+template <auto MemberPointer>
+struct BoundPointer<Member<MemberPointer> > {
+  using Type = decltype(MemberPointer);
+};
+
+template <typename BaseType, typename Binding, typename TagAndSignatureType>
+constexpr void enforce_binding();
+
+template <typename T, typename Binding, typename TagAndSignatureType>
+[[nodiscard]] auto stored_binding(const Binding &binding) -> std::any {
+  using Signature = typename TagAndSignatureType::Signature;
+  using ArgTypes = typename SignatureHelper<Signature>::ArgTypes;
+  if constexpr (BindingHelper<Binding, std::decay_t<T>, ArgTypes,
+                              TagAndSignatureType::is_const>::is_stored) {
+    return std::make_any<Binding>(binding);
+  } else {
+    return {};
+  }
+}
+
+template <typename T, typename Binding, typename TagAndSignatureType>
 [[nodiscard]] auto member_function() {
-  using MemberSignature = MemberFunctionSignatureHelper<MemberFunction>;
+  using Signature = typename TagAndSignatureType::Signature;
   using ArgTypes = typename detail::SignatureHelper<Signature>::ArgTypes;
+  using ReturnType = typename detail::SignatureHelper<Signature>::ReturnType;
   using BaseType = std::decay_t<T>;
+  using Binder = BindingHelper<Binding, BaseType, ArgTypes,
+                               TagAndSignatureType::is_const>;
+  constexpr auto is_noexcept = SignatureHelper<Signature>::is_noexcept;
+
+  enforce_binding<BaseType, Binding, TagAndSignatureType>();
 
-  static_assert(
-      std::is_same_v<BaseType, typename MemberSignature::Name>,
-      "The object type does not match the member function's object type.");
-
-  if constexpr (MemberSignature::is_const) {
-    return [](const std::any &object, const std::any &pointer_to_member,
-              ArgTypes &&args) {
-      const auto any_as_t =
-          std::tuple<const BaseType &>{std::any_cast<const BaseType &>(object)};
-      const auto any_as_mem_fun =
-          std::any_cast<MemberFunction>(pointer_to_member);
-      return std::apply(any_as_mem_fun,
-                        std::tuple_cat(any_as_t, std::move(args)));
+  // The object always holds a BaseType, so the pointer form of std::any_cast
+  // is used, which has no throwing path.
+  if constexpr (Binder::is_const) {
+    return [](const std::any &object, const std::any &binding,
+              ArgTypes &&args) noexcept(is_noexcept) -> ReturnType {
+      return Binder::invoke(binding, *std::any_cast<BaseType>(&object),
+                            std::move(args));
     };
   } else {
-    return [](std::any &object, const std::any &pointer_to_member,
-              ArgTypes &&args) {
-      auto any_as_t = std::tuple<BaseType &>{std::any_cast<BaseType &>(object)};
-      const auto any_as_mem_fun =
-          std::any_cast<MemberFunction>(pointer_to_member);
-      return std::apply(any_as_mem_fun,
-                        std::tuple_cat(any_as_t, std::move(args)));
+    return [](std::any &object, const std::any &binding,
+              ArgTypes &&args) noexcept(is_noexcept) -> ReturnType {
+      return Binder::invoke(binding, *std::any_cast<BaseType>(&object),
+                            std::move(args));
     };
   }
 }
@@ -82,6 +176,32 @@ template <typename... TagAndSignatureTypes>
   return ConstMap{TagAndSignatureTypes::is_const...};
 }
 
+template <typename... TagAndSignatureTypes>
+[[nodiscard]] constexpr auto noexcept_map() {
+  using NoexceptMap = typename TagValueMap<bool, TagAndSignatureTypes...>::Map;
+  return NoexceptMap{SignatureHelper<
+      typename TagAndSignatureTypes::Signature>::is_noexcept...};
+}
+
+template <typename CallTag, typename... TagAndSignatureTypes>
+using TagArgTypes = typename SignatureHelper<std::tuple_element_t<
+    UniqueIndex<CallTag,
+                std::tuple<typename TagAndSignatureTypes::Tag...> >::value,
+    std::tuple<typename TagAndSignatureTypes::Signature...> > >::ArgTypes;
+
+// Call arguments are converted to the signature's parameter types before the
+// noexcept thunk is entered, so calls are only noexcept if the conversions
+// are too.
+template <typename CallTag, typename... TagAndSignatureTypes>
+struct NothrowCall {
+  template <typename... Args>
+  static constexpr bool value =
+      noexcept_map<TagAndSignatureTypes...>().template get<CallTag>() &&
+      std::is_nothrow_constructible_v<
+          TagArgTypes<CallTag, TagAndSignatureTypes...>,
+          std::tuple<Args &&...> >;
+};
+
 template <typename MemberFunction, typename TagAndSignatureType>
 [[nodiscard]] constexpr auto constness_matches() -> bool {
   using MemberSignature = MemberFunctionSignatureHelper<MemberFunction>;
@@ -94,5 +214,83 @@ constexpr void enforce_constness() {
                 "const TypeErased member functions must be constructed with "
                 "const member functions.");
 }
+
+template <typename MemberFunction, typename TagAndSignatureType>
+[[nodiscard]] constexpr auto noexcept_matches() -> bool {
+  using MemberSignature = MemberFunctionSignatureHelper<MemberFunction>;
+  using Signature = typename TagAndSignatureType::Signature;
+  return !SignatureHelper<Signature>::is_noexcept ||
+         MemberSignature::is_noexcept;
+}
+
+template <typename MemberFunction, typename TagAndSignatureType>
+constexpr void enforce_noexcept() {
+  static_assert(noexcept_matches<MemberFunction, TagAndSignatureType>(),
+                "noexcept TypeErased member functions must be constructed "
+                "with noexcept member functions.");
+}
+
+template <typename BaseType, typename Binding, typename TagAndSignatureType>
+constexpr void enforce_binding() {
+  using Signature = typename TagAndSignatureType::Signature;
+  using ArgTypes = typename SignatureHelper<Signature>::ArgTypes;
+  using Binder = BindingHelper<Binding, BaseType, ArgTypes,
+                               TagAndSignatureType::is_const>;
+  using Bound = typename BoundPointer<Binding>::Type;
+
+  if constexpr (std::is_member_function_pointer_v<Bound>) {
+    static_assert(
+        std::is_same_v<BaseType,
+                       typename MemberFunctionSignatureHelper<Bound>::Name>,
+        "The object type does not match the member function's object type.");
+    enforce_constness<Bound, TagAndSignatureType>();
+    enforce_noexcept<Bound, TagAndSignatureType>();
+  } else {
+    if constexpr (std::is_member_object_pointer_v<Bound>) {
+      static_assert(
+          std::is_same_v<BaseType, typename MemberPointerHelper<Bound>::Name>,
+          "The object type does not match the data member's object type.");
+    }
+    static_assert(Binder::is_invocable,
+                  "The binding cannot be called with the object and the "
+                  "signature's arguments.");
+    static_assert(!TagAndSignatureType::is_const || Binder::is_const,
+                  "const TypeErased member functions must be constructed with "
+                  "bindings callable on a const object.");
+    static_assert(!SignatureHelper<Signature>::is_noexcept ||
+                      Binder::is_noexcept,
+                  "noexcept TypeErased member functions must be constructed "
+                  "with noexcept bindings.");
+  }
+}
+
+template <typename CallTag, typename Object, typename ArgTuple>
+auto call_with_tuple(Object &object, ArgTuple &&args) {
+  return std::apply(
+      [&object](auto &&...call_args) {
+        using Result = decltype(object.template call<CallTag>(
+            std::forward<decltype(call_args)>(call_args)...));
+        if constexpr (std::is_void_v<Result>) {
+          object.template call<CallTag>(
+              std::forward<decltype(call_args)>(call_args)...);
+          return std::monostate{};
+        } else {
+          return object.template call<CallTag>(
+              std::forward<decltype(call_args)>(call_args)...);
+        }
+      },
+      std::forward<ArgTuple>(args));
+}
+
+template <typename... CallTags, typename Object, typename... ArgTuples>
+auto call_many(Object &object, ArgTuples &&...arg_tuples) {
+  static_assert(sizeof...(CallTags) == sizeof...(ArgTuples),
+                "call_many requires one argument tuple per tag.");
+  // Braced initialization evaluates the calls in order.
+  return std::tuple<decltype(call_with_tuple<CallTags>(
+      object, std::forward<ArgTuples>(arg_tuples)))...>{
+      call_with_tuple<CallTags>(object,
+                                std::forward<ArgTuples>(arg_tuples))...};
+}
 }  // namespace detail
 }  // namespace gte
@@ -5,6 +5,8 @@
 #include <cassert>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <variant>
 
 #include "generic-type-erasure-impl.hpp"
@@ -26,23 +28,30 @@ struct ConstMemberSignature {
   static constexpr bool is_const = true;
 };
 
+template <typename Wrapper>
+struct Layout;
+
 template <typename... MemberSignatureTypes>
 class TypeErased {
  public:
-  template <typename T, typename... MemberFunctions,
+  // Each tag is bound to a member function pointer, a callable taking the
+  // object as its first parameter, or a compile-time gte::member binding of a
+  // member function, data member or free function.
+  template <typename T, typename... Bindings,
             std::enable_if_t<!std::is_same_v<std::decay_t<T>, TypeErased>,
                              bool> = true>
-  TypeErased(T &&t, const MemberFunctions &...member_functions)
+  TypeErased(T &&t, const Bindings &...bindings)
       : m_wrapped_member_functions{detail::member_function<
-            T, MemberFunctions, typename MemberSignatureTypes::Signature>()...},
+            T, std::decay_t<Bindings>, MemberSignatureTypes>()...},
         m_object_member_functions{
-            std::make_any<MemberFunctions>(member_functions)...},
-        m_object{std::forward<T>(t)} {
-    (detail::enforce_constness<MemberFunctions, MemberSignatureTypes>(), ...);
-  }
+            detail::stored_binding<T, std::decay_t<Bindings>,
+                                   MemberSignatureTypes>(bindings)...},
+        m_object{std::forward<T>(t)} {}
 
   template <typename CallTag, typename... Args>
-  auto call(Args &&...args) const {
+  auto call(Args &&...args) const noexcept(
+      detail::NothrowCall<CallTag, MemberSignatureTypes...>::template value<
+          Args...>) {
     constexpr auto is_const =
         m_member_function_is_const.template get<CallTag>();
     static_assert(is_const,
@@ -60,21 +69,62 @@ class TypeErased {
   }
 
   template <typename CallTag, typename... Args>
-  auto call(Args &&...args) {
-    const auto &wrapped_member =
-        m_wrapped_member_functions.template get<CallTag>();
-    return std::visit(
-        [&args..., this](const auto &function) {
-          const auto &object_member =
-              m_object_member_functions.template get<CallTag>();
-          return (*function)(
-              m_object, object_member,
-              std::forward_as_tuple(std::forward<Args>(args)...));
-        },
-        wrapped_member);
+  auto call(Args &&...args) noexcept(
+      detail::NothrowCall<CallTag, MemberSignatureTypes...>::template value<
+          Args...>) {
+    if constexpr (m_member_function_is_const.template get<CallTag>()) {
+      // Const tags are always constructed with const member functions, so
+      // there is no need to visit the wrapped member.
+      return std::as_const(*this).template call<CallTag>(
+          std::forward<Args>(args)...);
+    } else {
+      const auto &wrapped_member =
+          m_wrapped_member_functions.template get<CallTag>();
+      return std::visit(
+          [&args..., this](const auto &function) {
+            const auto &object_member =
+                m_object_member_functions.template get<CallTag>();
+            return (*function)(
+                m_object, object_member,
+                std::forward_as_tuple(std::forward<Args>(args)...));
+          },
+          wrapped_member);
+    }
+  }
+
+  // Calls each of CallTags in order with the arguments in the matching tuple,
+  // returning a tuple of the results. Void results are std::monostate.
+  template <typename... CallTags, typename... ArgTuples>
+  auto call_many(ArgTuples &&...arg_tuples) const {
+    return detail::call_many<CallTags...>(
+        *this, std::forward<ArgTuples>(arg_tuples)...);
+  }
+
+  template <typename... CallTags, typename... ArgTuples>
+  auto call_many(ArgTuples &&...arg_tuples) {
+    return detail::call_many<CallTags...>(
+        *this, std::forward<ArgTuples>(arg_tuples)...);
+  }
+
+  [[nodiscard]] auto target_type() const noexcept -> const std::type_info & {
+    return m_object.type();
+  }
+
+  // Pointer to the erased object if it is a T, otherwise nullptr.
+  template <typename T>
+  [[nodiscard]] auto target() const noexcept -> const T * {
+    return std::any_cast<T>(&m_object);
+  }
+
+  template <typename T>
+  [[nodiscard]] auto target() noexcept -> T * {
+    return std::any_cast<T>(&m_object);
   }
 
  private:
+  template <typename Wrapper>
+  friend struct Layout;
+
   using WrappedMemberTypeMap =
       typename detail::TagMemberFunctionMap<MemberSignatureTypes...>::Map;
   using MemberFunctionTypeMap =
@@ -84,6 +134,9 @@ class TypeErased {
       detail::const_map<MemberSignatureTypes...>();
 
   WrappedMemberTypeMap m_wrapped_member_functions;
+  // One binding slot per tag, left empty for bindings that are not stored.
+  // The wrapper type does not depend on the bindings, so the slot is always
+  // reserved.
   MemberFunctionTypeMap m_object_member_functions;
 
   std::any m_object;
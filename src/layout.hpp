@@ -0,0 +1,127 @@
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+
+#include <any>
+#include <cstddef>
+#include <type_traits>
+
+#include "generic-type-erasure.hpp"
+
+namespace gte {
+namespace detail {
+// Mirrors the small object rule of std::any in the standard library in use.
+// Unknown standard libraries are assumed to heap allocate every object, so
+// footprints are never underestimated.
+template <typename T>
+[[nodiscard]] constexpr auto any_stores_inline() -> bool {
+#if defined(__GLIBCXX__)
+  return std::is_nothrow_move_constructible_v<T> &&
+         sizeof(T) <= sizeof(void *) && alignof(T) <= alignof(void *);
+#elif defined(_LIBCPP_VERSION)
+  return std::is_nothrow_move_constructible_v<T> &&
+         sizeof(T) <= 3 * sizeof(void *) && alignof(void *) % alignof(T) == 0;
+#else
+  return false;
+#endif
+}
+}  // namespace detail
+
+// True if Wrapper stores a T inside the wrapper rather than on the heap.
+template <typename Wrapper, typename T>
+inline constexpr bool stores_inline =
+    detail::any_stores_inline<std::decay_t<T> >();
+
+// Compile-time breakdown of the memory used by a TypeErased wrapper, e.g.
+// static_assert(gte::Layout<Pet>::dispatch_bytes <= 128).
+template <typename Wrapper>
+struct Layout;
+
+template <typename... MemberSignatureTypes>
+struct Layout<TypeErased<MemberSignatureTypes...> > {
+ private:
+  using Wrapper = TypeErased<MemberSignatureTypes...>;
+
+ public:
+  static constexpr std::size_t tag_count = sizeof...(MemberSignatureTypes);
+
+  // Per-tag call thunks and binding slots.
+  static constexpr std::size_t thunk_bytes =
+      sizeof(typename Wrapper::WrappedMemberTypeMap);
+  static constexpr std::size_t binding_bytes =
+      sizeof(typename Wrapper::MemberFunctionTypeMap);
+  static constexpr std::size_t dispatch_bytes = thunk_bytes + binding_bytes;
+
+  // The std::any holding the erased object.
+  static constexpr std::size_t object_bytes = sizeof(std::any);
+
+  // The whole wrapper, including padding.
+  static constexpr std::size_t total_bytes = sizeof(Wrapper);
+
+  // Bytes allocated for bindings that are stored in a std::any but do not fit
+  // in its small object buffer. Member function pointers are two pointers
+  // wide on common ABIs, so each &T::function binding is heap allocated on
+  // libstdc++. gte::member bindings are never stored, and captureless
+  // lambdas are only left unstored from C++20.
+  template <typename... Bindings>
+  static constexpr std::size_t binding_heap_bytes =
+      (std::size_t{0} + ... +
+       (detail::is_stored_binding<std::decay_t<Bindings> > &&
+                !stores_inline<Wrapper, Bindings>
+            ? sizeof(std::decay_t<Bindings>)
+            : 0));
+
+  // Bytes used by a wrapper holding a T constructed with Bindings: the
+  // wrapper itself plus the heap allocated T and bindings. Allocator overhead
+  // is not counted.
+  template <typename T, typename... Bindings>
+  static constexpr std::size_t footprint =
+      total_bytes +
+      (stores_inline<Wrapper, T> ? 0 : sizeof(std::decay_t<T>)) +
+      binding_heap_bytes<Bindings...>;
+};
+
+// A type held by a wrapper together with the types of its bindings, for
+// Budget, e.g. gte::Footprint<Cat, decltype(&Cat::weight)>.
+template <typename T, typename... Bindings>
+struct Footprint {};
+
+namespace detail {
+template <typename Wrapper, typename T>
+struct FootprintOf {
+  static constexpr std::size_t value = Layout<Wrapper>::template footprint<T>;
+};
+
+template <typename Wrapper, typename T, typename... Bindings>
+struct FootprintOf<Wrapper, Footprint<T, Bindings...> > {
+  static constexpr std::size_t value =
+      Layout<Wrapper>::template footprint<T, Bindings...>;
+};
+}  // namespace detail
+
+// Fails compilation if a wrapper, or a wrapper holding any of Ts, uses more
+// than Bytes, e.g.
+// static_assert(gte::Budget<256>::check<Pet, Cat, Dog>()). Each of Ts is a
+// held type, or a gte::Footprint of a held type and its bindings so that heap
+// allocated bindings are counted too.
+template <std::size_t Bytes>
+struct Budget {
+  static constexpr std::size_t bytes = Bytes;
+
+  template <typename Wrapper, typename... Ts>
+  static constexpr bool fits =
+      Layout<Wrapper>::total_bytes <= Bytes &&
+      ((detail::FootprintOf<Wrapper, Ts>::value <= Bytes) && ...);
+
+  template <typename Wrapper, typename... Ts>
+  static constexpr auto check() -> bool {
+    static_assert(Layout<Wrapper>::total_bytes <= Bytes,
+                  "The wrapper exceeds its footprint budget.");
+    static_assert(
+        ((detail::FootprintOf<Wrapper, Ts>::value <= Bytes) && ...),
+        "A wrapper holding one of the types exceeds its footprint budget.");
+    return true;
+  }
+};
+}  // namespace gte
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef MEMBER_HPP
+#define MEMBER_HPP
+
+namespace gte {
+// Binds a member to a tag at compile time, e.g. gte::member<&Dog::speak>.
+// The member pointer is part of the type, so no pointer to member needs to be
+// stored with the wrapper.
+template <auto MemberPointer>
+struct Member {
+  static constexpr auto pointer = MemberPointer;
+};
+
+template <auto MemberPointer>
+inline constexpr auto member = Member<MemberPointer>{};
+}  // namespace gte
+
+#endif
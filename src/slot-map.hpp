@@ -0,0 +1,230 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "generic-type-erasure.hpp"
+
+namespace gte {
+// Refers to an object in an ErasedSlotMap: a 32-bit slot index and the 32-bit
+// generation of the slot when the object was inserted. Handles to erased
+// objects never refer to objects inserted later into the same slot. A default
+// constructed handle refers to no object.
+class SlotHandle {
+ public:
+  constexpr SlotHandle() = default;
+  constexpr SlotHandle(const std::uint32_t index,
+                       const std::uint32_t generation)
+      : m_value{static_cast<std::uint64_t>(generation) << 32 | index} {}
+
+  [[nodiscard]] static constexpr auto from_value(const std::uint64_t value)
+      -> SlotHandle {
+    return SlotHandle{static_cast<std::uint32_t>(value),
+                      static_cast<std::uint32_t>(value >> 32)};
+  }
+
+  [[nodiscard]] constexpr auto value() const -> std::uint64_t {
+    return m_value;
+  }
+  [[nodiscard]] constexpr auto index() const -> std::uint32_t {
+    return static_cast<std::uint32_t>(m_value);
+  }
+  [[nodiscard]] constexpr auto generation() const -> std::uint32_t {
+    return static_cast<std::uint32_t>(m_value >> 32);
+  }
+
+  friend constexpr auto operator==(const SlotHandle lhs, const SlotHandle rhs)
+      -> bool {
+    return lhs.m_value == rhs.m_value;
+  }
+  friend constexpr auto operator!=(const SlotHandle lhs, const SlotHandle rhs)
+      -> bool {
+    return lhs.m_value != rhs.m_value;
+  }
+
+ private:
+  std::uint64_t m_value = 0;
+};
+
+// Stores TypeErased objects contiguously and refers to them with generational
+// handles. Insertion and erasure are O(1); erasure moves the last object into
+// the erased position, so iteration order is not stable but handles are.
+template <typename... MemberSignatureTypes>
+class ErasedSlotMap {
+ public:
+  using Wrapper = TypeErased<MemberSignatureTypes...>;
+  using iterator = typename std::vector<Wrapper>::iterator;
+  using const_iterator = typename std::vector<Wrapper>::const_iterator;
+
+  // Constructs the wrapper in place, e.g. emplace(Cat{}, &Cat::weight).
+  template <typename T, typename... Bindings>
+  auto emplace(T &&t, const Bindings &...bindings) -> SlotHandle {
+    return insert(Wrapper{std::forward<T>(t), bindings...});
+  }
+
+  auto insert(Wrapper wrapper) -> SlotHandle {
+    const auto is_new_slot = m_free_head == no_slot;
+    if (is_new_slot) {
+      if (m_slots.size() == no_slot) {
+        throw std::length_error{"ErasedSlotMap is full."};
+      }
+      m_slots.push_back(Slot{first_generation, no_slot});
+    }
+    const auto index = is_new_slot
+                           ? static_cast<std::uint32_t>(m_slots.size() - 1)
+                           : m_free_head;
+    try {
+      m_objects.push_back(std::move(wrapper));
+      try {
+        m_slot_of_object.push_back(index);
+      } catch (...) {
+        m_objects.pop_back();
+        throw;
+      }
+    } catch (...) {
+      if (is_new_slot) {
+        m_slots.pop_back();
+      }
+      throw;
+    }
+
+    auto &slot = m_slots[index];
+    if (!is_new_slot) {
+      m_free_head = slot.next;
+    }
+    slot.next = static_cast<std::uint32_t>(m_objects.size() - 1);
+    return SlotHandle{index, slot.generation};
+  }
+
+  // Returns false if handle does not refer to an object.
+  auto erase(const SlotHandle handle) -> bool {
+    if (!contains(handle)) {
+      return false;
+    }
+    auto &slot = m_slots[handle.index()];
+    const auto object_index = slot.next;
+    const auto last_index = static_cast<std::uint32_t>(m_objects.size() - 1);
+    if (object_index != last_index) {
+      m_objects[object_index] = std::move(m_objects[last_index]);
+      m_slot_of_object[object_index] = m_slot_of_object[last_index];
+      m_slots[m_slot_of_object[object_index]].next = object_index;
+    }
+    m_objects.pop_back();
+    m_slot_of_object.pop_back();
+
+    // Slots are retired rather than reused once their generation runs out, so
+    // that stale handles can never match a later object.
+    if (slot.generation == std::numeric_limits<std::uint32_t>::max()) {
+      slot.generation = 0;
+    } else {
+      ++slot.generation;
+      slot.next = m_free_head;
+      m_free_head = handle.index();
+    }
+    return true;
+  }
+
+  [[nodiscard]] auto contains(const SlotHandle handle) const -> bool {
+    return handle.index() < m_slots.size() && handle.generation() != 0 &&
+           m_slots[handle.index()].generation == handle.generation() &&
+           is_occupied(handle.index());
+  }
+
+  // Pointer to the object referred to by handle, or nullptr.
+  [[nodiscard]] auto find(const SlotHandle handle) -> Wrapper * {
+    return contains(handle) ? &m_objects[m_slots[handle.index()].next]
+                            : nullptr;
+  }
+
+  [[nodiscard]] auto find(const SlotHandle handle) const -> const Wrapper * {
+    return contains(handle) ? &m_objects[m_slots[handle.index()].next]
+                            : nullptr;
+  }
+
+  [[nodiscard]] auto at(const SlotHandle handle) -> Wrapper & {
+    return m_objects[checked_object_index(handle)];
+  }
+
+  [[nodiscard]] auto at(const SlotHandle handle) const -> const Wrapper & {
+    return m_objects[checked_object_index(handle)];
+  }
+
+  // Throws std::out_of_range if handle does not refer to an object.
+  template <typename CallTag, typename... Args>
+  auto call(const SlotHandle handle, Args &&...args) const {
+    return at(handle).template call<CallTag>(std::forward<Args>(args)...);
+  }
+
+  template <typename CallTag, typename... Args>
+  auto call(const SlotHandle handle, Args &&...args) {
+    return at(handle).template call<CallTag>(std::forward<Args>(args)...);
+  }
+
+  // Handle of the object at position index of the iteration order.
+  [[nodiscard]] auto handle(const std::size_t index) const -> SlotHandle {
+    const auto slot_index = m_slot_of_object.at(index);
+    return SlotHandle{slot_index, m_slots[slot_index].generation};
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t { return m_objects.size(); }
+  [[nodiscard]] auto empty() const -> bool { return m_objects.empty(); }
+
+  void reserve(const std::size_t size) {
+    m_objects.reserve(size);
+    m_slot_of_object.reserve(size);
+    m_slots.reserve(size);
+  }
+
+  // Erases all objects. Outstanding handles stay invalid.
+  void clear() {
+    while (!m_objects.empty()) {
+      erase(handle(m_objects.size() - 1));
+    }
+  }
+
+  [[nodiscard]] auto begin() -> iterator { return m_objects.begin(); }
+  [[nodiscard]] auto end() -> iterator { return m_objects.end(); }
+  [[nodiscard]] auto begin() const -> const_iterator {
+    return m_objects.begin();
+  }
+  [[nodiscard]] auto end() const -> const_iterator { return m_objects.end(); }
+
+ private:
+  static constexpr auto no_slot = std::numeric_limits<std::uint32_t>::max();
+  static constexpr auto first_generation = std::uint32_t{1};
+
+  // next is the object index of an occupied slot, or the next free slot of a
+  // free slot.
+  struct Slot {
+    std::uint32_t generation;
+    std::uint32_t next;
+  };
+
+  [[nodiscard]] auto is_occupied(const std::uint32_t slot_index) const
+      -> bool {
+    const auto object_index = m_slots[slot_index].next;
+    return object_index < m_slot_of_object.size() &&
+           m_slot_of_object[object_index] == slot_index;
+  }
+
+  [[nodiscard]] auto checked_object_index(const SlotHandle handle) const
+      -> std::uint32_t {
+    if (!contains(handle)) {
+      throw std::out_of_range{"Invalid ErasedSlotMap handle."};
+    }
+    return m_slots[handle.index()].next;
+  }
+
+  std::vector<Slot> m_slots;
+  std::vector<Wrapper> m_objects;
+  std::vector<std::uint32_t> m_slot_of_object;
+  std::uint32_t m_free_head = no_slot;
+};
+}  // namespace gte
+
+#endif
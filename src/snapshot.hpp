@@ -0,0 +1,396 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "function.hpp"
+
+namespace gte {
+// Thrown when a snapshot cannot be written, or when a snapshot file is
+// missing, corrupt or refers to unregistered types.
+class SnapshotError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+using SnapshotTypeId = std::uint64_t;
+
+namespace detail {
+// File layout, in native byte order:
+//   header:  magic, version, record count, payload size
+//   records: one SnapshotRecord per object
+//   payload: the saved bytes of every object
+// Each record's checksum covers its type id, offset and size as well as its
+// payload bytes.
+constexpr auto snapshot_magic =
+    std::array<char, 8>{'G', 'T', 'E', 'S', 'N', 'A', 'P', '\0'};
+constexpr auto snapshot_version = std::uint64_t{2};
+
+struct SnapshotHeader {
+  std::array<char, 8> magic;
+  std::uint64_t version;
+  std::uint64_t num_records;
+  std::uint64_t payload_bytes;
+};
+
+struct SnapshotRecord {
+  SnapshotTypeId type_id;
+  std::uint64_t offset;
+  std::uint64_t size;
+  std::uint64_t checksum;
+};
+
+constexpr auto snapshot_checksum_basis = std::uint64_t{14695981039346656037u};
+
+// FNV-1a, used to detect corrupt records when an object is loaded.
+[[nodiscard]] inline auto snapshot_checksum(
+    const std::byte *data, const std::size_t size,
+    std::uint64_t hash = snapshot_checksum_basis) -> std::uint64_t {
+  for (auto index = std::size_t{0}; index < size; ++index) {
+    hash ^= static_cast<std::uint64_t>(data[index]);
+    hash *= std::uint64_t{1099511628211u};
+  }
+  return hash;
+}
+
+[[nodiscard]] inline auto record_checksum(const SnapshotRecord &record,
+                                          const std::byte *data)
+    -> std::uint64_t {
+  const auto fields =
+      std::array<std::uint64_t, 3>{record.type_id, record.offset, record.size};
+  const auto hash = snapshot_checksum(
+      reinterpret_cast<const std::byte *>(fields.data()), sizeof(fields));
+  return snapshot_checksum(data, record.size, hash);
+}
+
+template <typename T>
+void append_bytes(const T &value, std::vector<std::byte> &bytes) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  const auto *begin = reinterpret_cast<const std::byte *>(&value);
+  bytes.insert(bytes.end(), begin, begin + sizeof(T));
+}
+
+template <typename T>
+[[nodiscard]] auto read_bytes(const std::byte *data) -> T {
+  static_assert(std::is_trivially_copyable_v<T>);
+  auto value = T{};
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+// Writes all of size bytes to descriptor, retrying partial and interrupted
+// writes.
+[[nodiscard]] inline auto write_all(const int descriptor, const void *data,
+                                    std::size_t size) -> bool {
+  const auto *bytes = static_cast<const char *>(data);
+  while (size > 0) {
+    const auto written = ::write(descriptor, bytes, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+// Flushes the directory entry of path to disk, so a rename over path is
+// durable.
+[[nodiscard]] inline auto sync_parent_directory(const std::string &path)
+    -> bool {
+  auto directory = std::filesystem::path{path}.parent_path();
+  if (directory.empty()) {
+    directory = ".";
+  }
+  const auto descriptor = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (descriptor < 0) {
+    return false;
+  }
+  const auto synced = ::fsync(descriptor) == 0;
+  ::close(descriptor);
+  return synced;
+}
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string &path) {
+    const auto descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      throw SnapshotError{"Could not open snapshot " + path + "."};
+    }
+    struct stat status {};
+    if (::fstat(descriptor, &status) != 0) {
+      ::close(descriptor);
+      throw SnapshotError{"Could not read the size of snapshot " + path + "."};
+    }
+    m_size = static_cast<std::size_t>(status.st_size);
+    if (m_size > 0) {
+      auto *mapping =
+          ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (mapping == MAP_FAILED) {
+        ::close(descriptor);
+        throw SnapshotError{"Could not map snapshot " + path + "."};
+      }
+      m_data = static_cast<const std::byte *>(mapping);
+    }
+    ::close(descriptor);
+  }
+
+  MappedFile(MappedFile &&other) noexcept
+      : m_data{std::exchange(other.m_data, nullptr)},
+        m_size{std::exchange(other.m_size, 0)} {}
+
+  auto operator=(MappedFile &&other) noexcept -> MappedFile & {
+    if (this != &other) {
+      unmap();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  ~MappedFile() { unmap(); }
+
+  [[nodiscard]] auto data() const -> const std::byte * { return m_data; }
+  [[nodiscard]] auto size() const -> std::size_t { return m_size; }
+
+ private:
+  void unmap() noexcept {
+    if (m_data != nullptr) {
+      ::munmap(const_cast<std::byte *>(m_data), m_size);
+    }
+  }
+
+  const std::byte *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+}  // namespace detail
+
+// Maps the concrete types erased by Wrapper to stable ids, with hooks to save
+// and load them. Every concrete type in a snapshot must be registered.
+template <typename Wrapper>
+class SnapshotRegistry {
+ public:
+  // Saves and loads T with memcpy. make_wrapper converts a loaded T to a
+  // Wrapper, e.g. pet_from_cat.
+  template <typename T, typename MakeWrapper>
+  void add(const SnapshotTypeId id, MakeWrapper make_wrapper) {
+    static_assert(std::is_trivially_copyable_v<T> &&
+                      std::is_default_constructible_v<T>,
+                  "Types without save and load hooks must be trivially "
+                  "copyable and default constructible.");
+    add<T>(
+        id, std::move(make_wrapper),
+        [](const T &object, std::vector<std::byte> &bytes) {
+          detail::append_bytes(object, bytes);
+        },
+        [](const std::byte *data, const std::size_t size) {
+          if (size != sizeof(T)) {
+            throw SnapshotError{"Snapshot object has the wrong size."};
+          }
+          return detail::read_bytes<T>(data);
+        });
+  }
+
+  // Saves T by appending its bytes with save(const T &, std::vector<std::byte>
+  // &), and loads it with load(const std::byte *, std::size_t) -> T.
+  template <typename T, typename MakeWrapper, typename Save, typename Load>
+  void add(const SnapshotTypeId id, MakeWrapper make_wrapper, Save save,
+           Load load) {
+    if (m_entry_by_id.count(id) != 0 ||
+        m_entry_by_type.count(typeid(T)) != 0) {
+      throw std::invalid_argument{
+          "Snapshot types and ids must be registered once."};
+    }
+    m_entry_by_id.emplace(id, m_entries.size());
+    m_entry_by_type.emplace(typeid(T), m_entries.size());
+    m_entries.push_back(Entry{
+        id,
+        [save = std::move(save)](const Wrapper &wrapper,
+                                 std::vector<std::byte> &bytes) {
+          save(*wrapper.template target<T>(), bytes);
+        },
+        [make_wrapper = std::move(make_wrapper), load = std::move(load)](
+            const std::byte *data, const std::size_t size) -> Wrapper {
+          return make_wrapper(load(data, size));
+        }});
+  }
+
+  // Appends the bytes of the object erased by wrapper and returns its id.
+  auto save(const Wrapper &wrapper, std::vector<std::byte> &bytes) const
+      -> SnapshotTypeId {
+    const auto entry = m_entry_by_type.find(wrapper.target_type());
+    if (entry == m_entry_by_type.end()) {
+      throw SnapshotError{std::string{"Unregistered snapshot type "} +
+                          wrapper.target_type().name() + "."};
+    }
+    const auto &registered = m_entries[entry->second];
+    registered.save(wrapper, bytes);
+    return registered.id;
+  }
+
+  [[nodiscard]] auto load(const SnapshotTypeId id, const std::byte *data,
+                          const std::size_t size) const -> Wrapper {
+    const auto entry = m_entry_by_id.find(id);
+    if (entry == m_entry_by_id.end()) {
+      throw SnapshotError{"Unregistered snapshot type id " +
+                          std::to_string(id) + "."};
+    }
+    return m_entries[entry->second].load(data, size);
+  }
+
+ private:
+  struct Entry {
+    SnapshotTypeId id;
+    Function<void(const Wrapper &, std::vector<std::byte> &) const> save;
+    Function<Wrapper(const std::byte *, std::size_t) const> load;
+  };
+
+  std::vector<Entry> m_entries;
+  std::unordered_map<SnapshotTypeId, std::size_t> m_entry_by_id;
+  std::unordered_map<std::type_index, std::size_t> m_entry_by_type;
+};
+
+template <typename Wrapper>
+void save_snapshot(const std::string &path,
+                   const std::vector<Wrapper> &wrappers,
+                   const SnapshotRegistry<Wrapper> &registry) {
+  auto records = std::vector<detail::SnapshotRecord>{};
+  records.reserve(wrappers.size());
+  auto payload = std::vector<std::byte>{};
+  for (const auto &wrapper : wrappers) {
+    const auto offset = payload.size();
+    const auto type_id = registry.save(wrapper, payload);
+    const auto size = payload.size() - offset;
+    auto record = detail::SnapshotRecord{type_id, offset, size, 0};
+    record.checksum = detail::record_checksum(record, payload.data() + offset);
+    records.push_back(record);
+  }
+
+  const auto header =
+      detail::SnapshotHeader{detail::snapshot_magic, detail::snapshot_version,
+                             records.size(), payload.size()};
+  // Written and synced to a temporary file that is then renamed over path,
+  // so that a failed save or a crash leaves either the previous or the new
+  // snapshot, never a partial one.
+  const auto temporary_path = path + ".tmp";
+  const auto descriptor =
+      ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor < 0) {
+    throw SnapshotError{"Could not write snapshot " + path + "."};
+  }
+  const auto written =
+      detail::write_all(descriptor, &header, sizeof(header)) &&
+      detail::write_all(descriptor, records.data(),
+                        records.size() * sizeof(detail::SnapshotRecord)) &&
+      detail::write_all(descriptor, payload.data(), payload.size()) &&
+      ::fsync(descriptor) == 0;
+  const auto closed = ::close(descriptor) == 0;
+  auto error = std::error_code{};
+  if (!written || !closed) {
+    std::filesystem::remove(temporary_path, error);
+    throw SnapshotError{"Could not write snapshot " + path + "."};
+  }
+  std::filesystem::rename(temporary_path, path, error);
+  if (error) {
+    std::filesystem::remove(temporary_path, error);
+    throw SnapshotError{"Could not replace snapshot " + path + "."};
+  }
+  if (!detail::sync_parent_directory(path)) {
+    throw SnapshotError{"Could not sync the directory of snapshot " + path +
+                        "."};
+  }
+}
+
+// Memory-mapped snapshot. Opening only validates the header; each object is
+// validated and constructed when it is loaded. The registry must outlive the
+// snapshot.
+template <typename Wrapper>
+class Snapshot {
+ public:
+  Snapshot(const std::string &path, const SnapshotRegistry<Wrapper> &registry)
+      : m_file{path}, m_registry{&registry} {
+    if (m_file.size() < sizeof(detail::SnapshotHeader)) {
+      throw SnapshotError{"Snapshot " + path + " is truncated."};
+    }
+    const auto header =
+        detail::read_bytes<detail::SnapshotHeader>(m_file.data());
+    if (header.magic != detail::snapshot_magic ||
+        header.version != detail::snapshot_version) {
+      throw SnapshotError{path + " is not a snapshot."};
+    }
+    const auto records_bytes = m_file.size() - sizeof(detail::SnapshotHeader);
+    if (header.num_records > records_bytes / sizeof(detail::SnapshotRecord) ||
+        records_bytes - header.num_records * sizeof(detail::SnapshotRecord) !=
+            header.payload_bytes) {
+      throw SnapshotError{"Snapshot " + path + " is truncated."};
+    }
+    m_size = header.num_records;
+    m_records = m_file.data() + sizeof(detail::SnapshotHeader);
+    m_payload = m_records + m_size * sizeof(detail::SnapshotRecord);
+    m_payload_bytes = header.payload_bytes;
+  }
+
+  Snapshot(const std::string &path, SnapshotRegistry<Wrapper> &&) = delete;
+
+  [[nodiscard]] auto size() const -> std::size_t { return m_size; }
+
+  [[nodiscard]] auto load(const std::size_t index) const -> Wrapper {
+    if (index >= m_size) {
+      throw std::out_of_range{"Snapshot index out of range."};
+    }
+    const auto record = detail::read_bytes<detail::SnapshotRecord>(
+        m_records + index * sizeof(detail::SnapshotRecord));
+    if (record.offset > m_payload_bytes ||
+        record.size > m_payload_bytes - record.offset) {
+      throw SnapshotError{"Snapshot record is out of bounds."};
+    }
+    const auto *data = m_payload + record.offset;
+    if (detail::record_checksum(record, data) != record.checksum) {
+      throw SnapshotError{"Snapshot record is corrupt."};
+    }
+    return m_registry->load(record.type_id, data, record.size);
+  }
+
+  [[nodiscard]] auto load_all() const -> std::vector<Wrapper> {
+    auto wrappers = std::vector<Wrapper>{};
+    wrappers.reserve(m_size);
+    for (auto index = std::size_t{0}; index < m_size; ++index) {
+      wrappers.push_back(load(index));
+    }
+    return wrappers;
+  }
+
+ private:
+  detail::MappedFile m_file;
+  const SnapshotRegistry<Wrapper> *m_registry;
+  std::size_t m_size = 0;
+  const std::byte *m_records = nullptr;
+  const std::byte *m_payload = nullptr;
+  std::size_t m_payload_bytes = 0;
+};
+}  // namespace gte
+
+#endif
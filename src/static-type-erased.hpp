@@ -0,0 +1,90 @@
+#ifndef STATIC_TYPE_ERASED_HPP
+#define STATIC_TYPE_ERASED_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "generic-type-erasure.hpp"
+#include "member.hpp"
+#include "type-helpers.hpp"
+#include "type-map.hpp"
+
+namespace gte {
+namespace detail {
+template <typename Signature>
+using StaticMemberFunctionPtr = std::add_pointer_t<
+    typename SignatureWithExtraArgs<Signature, void *>::Signature>;
+
+template <typename T, auto MemberPointer, typename TagAndSignatureType>
+[[nodiscard]] constexpr auto static_member_function() {
+  using Signature = typename TagAndSignatureType::Signature;
+  using ArgTypes = typename SignatureHelper<Signature>::ArgTypes;
+  using ReturnType = typename SignatureHelper<Signature>::ReturnType;
+  using Binder = BindingHelper<Member<MemberPointer>, std::remove_cv_t<T>,
+                               ArgTypes, TagAndSignatureType::is_const>;
+  using Object = typename Binder::Object;
+  constexpr auto is_noexcept = SignatureHelper<Signature>::is_noexcept;
+
+  return [](void *object, ArgTypes &&args) noexcept(is_noexcept)
+             -> ReturnType {
+    return Binder::invoke(*static_cast<Object *>(object), std::move(args));
+  };
+}
+
+template <typename... TagAndSignatureTypes>
+struct TagStaticMemberFunctionMap {
+  using Map = TypeMap<
+      std::pair<typename TagAndSignatureTypes::Tag,
+                StaticMemberFunctionPtr<
+                    typename TagAndSignatureTypes::Signature> >...>;
+};
+
+template <typename T>
+[[nodiscard]] constexpr auto erase_pointer(T &object) -> void * {
+  // Members of const objects are only ever called through const thunks.
+  return const_cast<std::remove_cv_t<T> *>(&object);
+}
+}  // namespace detail
+
+// Non-owning counterpart of TypeErased for objects that outlive the wrapper,
+// typically objects with static storage duration. Members are bound with
+// gte::member<&T::function>, so construction is constexpr and wrappers can
+// be built at compile time, e.g. in constexpr or constinit registries.
+template <typename... MemberSignatureTypes>
+class StaticTypeErased {
+ public:
+  template <typename T, auto... MemberPointers>
+  constexpr StaticTypeErased(T &object, Member<MemberPointers>...)
+      : m_member_functions{detail::static_member_function<
+            T, MemberPointers, MemberSignatureTypes>()...},
+        m_object{detail::erase_pointer(object)} {
+    static_assert(
+        !std::is_const_v<T> || (MemberSignatureTypes::is_const && ...),
+        "Non-const members cannot be bound to a const object.");
+    (detail::enforce_binding<std::remove_cv_t<T>, Member<MemberPointers>,
+                             MemberSignatureTypes>(),
+     ...);
+  }
+
+  // The wrapper does not own the object, so calls are const and non-const tags
+  // modify the referenced object.
+  template <typename CallTag, typename... Args>
+  auto call(Args &&...args) const noexcept(
+      detail::NothrowCall<CallTag, MemberSignatureTypes...>::template value<
+          Args...>) {
+    const auto function = m_member_functions.template get<CallTag>();
+    return (*function)(m_object,
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+ private:
+  using MemberFunctionTypeMap =
+      typename detail::TagStaticMemberFunctionMap<MemberSignatureTypes...>::Map;
+
+  MemberFunctionTypeMap m_member_functions;
+  void *m_object;
+};
+}  // namespace gte
+
+#endif
@@ -12,13 +12,41 @@ template <typename R, typename... Args>
 struct SignatureHelper<R(Args...)> {
   using ReturnType = R;
   using ArgTypes = std::tuple<Args...>;
+  static constexpr auto is_const = false;
+  static constexpr auto is_noexcept = false;
+};
+
+template <typename R, typename... Args>
+struct SignatureHelper<R(Args...) const> {
+  using ReturnType = R;
+  using ArgTypes = std::tuple<Args...>;
+  static constexpr auto is_const = true;
+  static constexpr auto is_noexcept = false;
+};
+
+template <typename R, typename... Args>
+struct SignatureHelper<R(Args...) noexcept> {
+  using ReturnType = R;
+  using ArgTypes = std::tuple<Args...>;
+  static constexpr auto is_const = false;
+  static constexpr auto is_noexcept = true;
+};
+
+template <typename R, typename... Args>
+struct SignatureHelper<R(Args...) const noexcept> {
+  using ReturnType = R;
+  using ArgTypes = std::tuple<Args...>;
+  static constexpr auto is_const = true;
+  static constexpr auto is_noexcept = true;
 };
 
 template <typename BaseSignature, typename... ExtraArgs>
 struct SignatureWithExtraArgs {
   using ReturnType = typename SignatureHelper<BaseSignature>::ReturnType;
   using ArgTuple = typename SignatureHelper<BaseSignature>::ArgTypes;
-  using Signature = ReturnType(ExtraArgs..., ArgTuple &&);
+  static constexpr auto is_noexcept =
+      SignatureHelper<BaseSignature>::is_noexcept;
+  using Signature = ReturnType(ExtraArgs..., ArgTuple &&) noexcept(is_noexcept);
 };
 
 template <typename T>
@@ -30,6 +58,7 @@ struct MemberFunctionSignatureHelper<R (StructName::*)(Args...)> {
   using ReturnType = R;
   using ArgTypes = std::tuple<Args...>;
   static constexpr auto is_const = false;
+  static constexpr auto is_noexcept = false;
 };
 
 template <typename StructName, typename R, typename... Args>
@@ -38,6 +67,35 @@ struct MemberFunctionSignatureHelper<R (StructName::*)(Args...) const> {
   using ReturnType = R;
   using ArgTypes = std::tuple<Args...>;
   static constexpr auto is_const = true;
+  static constexpr auto is_noexcept = false;
+};
+
+template <typename StructName, typename R, typename... Args>
+struct MemberFunctionSignatureHelper<R (StructName::*)(Args...) noexcept> {
+  using Name = StructName;
+  using ReturnType = R;
+  using ArgTypes = std::tuple<Args...>;
+  static constexpr auto is_const = false;
+  static constexpr auto is_noexcept = true;
+};
+
+template <typename StructName, typename R, typename... Args>
+struct MemberFunctionSignatureHelper<R (StructName::*)(Args...)
+                                         const noexcept> {
+  using Name = StructName;
+  using ReturnType = R;
+  using ArgTypes = std::tuple<Args...>;
+  static constexpr auto is_const = true;
+  static constexpr auto is_noexcept = true;
+};
+
+template <typename T>
+struct MemberPointerHelper {};
+
+template <typename StructName, typename MemberType>
+struct MemberPointerHelper<MemberType StructName::*> {
+  using Name = StructName;
+  using Type = MemberType;
 };
 
 template <typename... Pairs>
@@ -1,50 +1,74 @@
 #ifndef TYPE_MAP_HPP
 #define TYPE_MAP_HPP
 
+#include <cstddef>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include "type-helpers.hpp"
 
 namespace gte {
 namespace detail {
-template <typename T, typename Tuple, std::size_t I>
-constexpr auto get_index_impl() -> std::size_t {
-  if constexpr (std::is_same_v<T, std::tuple_element_t<I, Tuple> >) {
-    return I;
-  } else {
-    return 0;
-  }
-}
+// Keys are indexed by inheriting one IndexedType base per key, so finding a
+// key's index is a single overload resolution instead of a recursive search.
+// A key that appears more than once gives an ambiguous base and is not found.
+template <typename T, std::size_t I>
+struct IndexedType {};
 
-template <typename T, typename Tuple, std::size_t... Indices>
-constexpr auto get_index(std::index_sequence<Indices...>) -> std::size_t {
-  return (get_index_impl<T, Tuple, Indices>() + ...);
-}
+template <typename Indices, typename... Ts>
+struct TypeIndexerImpl;
 
-template <typename T, typename Tuple, std::size_t... Indices>
-constexpr auto has_type(std::index_sequence<Indices...>) -> bool {
-  return (std::is_same_v<T, std::tuple_element_t<Indices, Tuple> > || ...);
-}
+template <std::size_t... Indices, typename... Ts>
+struct TypeIndexerImpl<std::index_sequence<Indices...>, Ts...>
+    : IndexedType<Ts, Indices>... {};
 
-template <typename T, typename Tuple, std::size_t... Indices>
-constexpr auto type_count(std::index_sequence<Indices...>) -> std::size_t {
-  return (static_cast<std::size_t>(
-              std::is_same_v<T, std::tuple_element_t<Indices, Tuple> >) +
-          ...);
+template <typename Tuple>
+struct TypeIndexer;
+
+template <typename... Ts>
+struct TypeIndexer<std::tuple<Ts...> >
+    : TypeIndexerImpl<std::index_sequence_for<Ts...>, Ts...> {};
+
+template <typename T, std::size_t I>
+constexpr auto indexed_type_index(const IndexedType<T, I> &) -> std::size_t {
+  return I;
 }
 
+template <typename T, typename Tuple, typename = void>
+struct UniqueIndex {
+  static constexpr bool found = false;
+};
+
+template <typename T, typename Tuple>
+struct UniqueIndex<T, Tuple,
+                   std::void_t<decltype(indexed_type_index<T>(
+                       std::declval<const TypeIndexer<Tuple> &>()))> > {
+  static constexpr bool found = true;
+  static constexpr std::size_t value =
+      indexed_type_index<T>(TypeIndexer<Tuple>{});
+};
+
 template <typename T, typename Tuple, std::size_t... Indices>
-constexpr auto type_is_unique(std::index_sequence<Indices...> indices)
-    -> std::size_t {
-  return type_count<T, Tuple>(indices) == 1;
+constexpr auto get_index(std::index_sequence<Indices...>) -> std::size_t {
+  static_assert(UniqueIndex<T, Tuple>::found,
+                "The type must appear exactly once.");
+  return UniqueIndex<T, Tuple>::value;
 }
 
+// Types are unique if each of them is found through the indexer, as a
+// duplicate type makes its lookup ambiguous.
+template <typename Tuple>
+struct AllTypesUnique;
+
+template <typename... Ts>
+struct AllTypesUnique<std::tuple<Ts...> >
+    : std::bool_constant<(UniqueIndex<Ts, std::tuple<Ts...> >::found &&
+                          ...)> {};
+
 template <typename Tuple, std::size_t... Indices>
-constexpr auto all_types_unique(std::index_sequence<Indices...> indices)
-    -> bool {
-  return (
-      type_is_unique<std::tuple_element_t<Indices, Tuple>, Tuple>(indices) &&
-      ...);
+constexpr auto all_types_unique(std::index_sequence<Indices...>) -> bool {
+  return AllTypesUnique<Tuple>::value;
 }
 }  // namespace detail
 
@@ -52,16 +76,13 @@ template <typename... KeyValuePairs>
 struct TypeMap {
   template <typename... Args>
   constexpr TypeMap(Args &&...args)
-      : m_values{std::forward_as_tuple(std::forward<Args>(args)...)} {
+      : m_values{std::forward<Args>(args)...} {
     static_assert(detail::all_types_unique<KeyTuple>(
         std::make_index_sequence<number_of_keys>()));
   }
 
   template <typename Key>
   constexpr const auto &get() const {
-    static_assert(detail::has_type<Key, KeyTuple>(
-        std::make_index_sequence<number_of_keys>()));
-
     constexpr auto key_index = detail::get_index<Key, KeyTuple>(
         std::make_index_sequence<number_of_keys>());
     return std::get<key_index>(m_values);
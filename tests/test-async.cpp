@@ -0,0 +1,207 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "executors.hpp"
+#include "future.hpp"
+#include "generic-type-erasure.hpp"
+
+namespace {
+struct TheAnswer {};
+struct Multiply {};
+struct SetTheAnswer {};
+struct Fail {};
+
+struct Tester {
+  int answer = 42;
+
+  auto the_answer() const -> int { return answer; }
+
+  auto multiply(const std::vector<int> &multipliers) const -> int {
+    auto result = answer;
+    for (const auto multiplier : multipliers) {
+      result *= multiplier;
+    }
+    return result;
+  }
+
+  void set_the_answer(const int new_value) { answer = new_value; }
+
+  auto fail() const -> int { throw std::runtime_error{"fail"}; }
+};
+
+using TheAnswerFunction = gte::ConstMemberSignature<TheAnswer, int()>;
+using MultiplyFunction =
+    gte::ConstMemberSignature<Multiply, int(const std::vector<int> &)>;
+using SetFunction = gte::MemberSignature<SetTheAnswer, void(int)>;
+using FailFunction = gte::ConstMemberSignature<Fail, int()>;
+using Wrapper = gte::TypeErased<TheAnswerFunction, MultiplyFunction,
+                                SetFunction, FailFunction>;
+
+auto make_wrapper() {
+  return Wrapper{Tester{}, &Tester::the_answer, &Tester::multiply,
+                 &Tester::set_the_answer, &Tester::fail};
+}
+
+// Counts tasks and runs them later, on demand.
+struct DeferredExecutor {
+  void execute(gte::ThreadPool::Task task) {
+    m_tasks.push_back(std::move(task));
+  }
+
+  void run_all() {
+    for (auto &task : m_tasks) {
+      task();
+    }
+    m_tasks.clear();
+  }
+
+  std::vector<gte::ThreadPool::Task> m_tasks;
+};
+
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  explicit CountingAllocator(int *count) : allocations{count} {}
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &other)
+      : allocations{other.allocations} {}
+
+  auto allocate(const std::size_t size) -> T * {
+    ++*allocations;
+    return std::allocator<T>{}.allocate(size);
+  }
+
+  void deallocate(T *pointer, const std::size_t size) {
+    std::allocator<T>{}.deallocate(pointer, size);
+  }
+
+  template <typename U>
+  auto operator==(const CountingAllocator<U> &other) const -> bool {
+    return allocations == other.allocations;
+  }
+
+  template <typename U>
+  auto operator!=(const CountingAllocator<U> &other) const -> bool {
+    return allocations != other.allocations;
+  }
+
+  int *allocations;
+};
+}  // namespace
+
+TEST_CASE("Async call on inline executor", "[async]") {
+  auto executor = gte::InlineExecutor{};
+  auto wrapper = make_wrapper();
+
+  auto set = gte::call_async<SetTheAnswer>(wrapper, executor, 43);
+  static_assert(std::is_same_v<decltype(set), gte::Future<void>>);
+  CHECK(set.ready());
+  set.get();
+  CHECK(!set.valid());
+
+  const auto &const_wrapper = wrapper;
+  auto answer = gte::call_async<TheAnswer>(const_wrapper, executor);
+  static_assert(std::is_same_v<decltype(answer), gte::Future<int>>);
+  CHECK(answer.get() == 43);
+}
+
+TEST_CASE("Async call arguments", "[async]") {
+  auto executor = DeferredExecutor{};
+  const auto wrapper = make_wrapper();
+
+  SECTION("Copied") {
+    auto multipliers = std::vector<int>{2};
+    auto result = gte::call_async<Multiply>(wrapper, executor, multipliers);
+    multipliers.push_back(0);
+    CHECK(!result.ready());
+    executor.run_all();
+    CHECK(result.get() == 84);
+  }
+  SECTION("Reference") {
+    auto multipliers = std::vector<int>{2};
+    auto result =
+        gte::call_async<Multiply>(wrapper, executor, std::cref(multipliers));
+    multipliers.push_back(3);
+    executor.run_all();
+    CHECK(result.get() == 252);
+  }
+}
+
+TEST_CASE("Async call allocator", "[async]") {
+  auto executor = gte::InlineExecutor{};
+  auto wrapper = make_wrapper();
+  auto allocations = 0;
+
+  auto set = gte::call_async<SetTheAnswer>(
+      std::allocator_arg, CountingAllocator<int>{&allocations}, wrapper,
+      executor, 43);
+  CHECK(allocations == 1);
+  set.get();
+
+  auto answer = gte::call_async<TheAnswer>(
+      std::allocator_arg, CountingAllocator<int>{&allocations},
+      std::as_const(wrapper), executor);
+  CHECK(allocations == 2);
+  CHECK(answer.get() == 43);
+}
+
+TEST_CASE("Async call exception", "[async]") {
+  auto executor = gte::InlineExecutor{};
+  const auto wrapper = make_wrapper();
+
+  auto result = gte::call_async<Fail>(wrapper, executor);
+  CHECK(result.ready());
+  CHECK_THROWS_AS(result.get(), std::runtime_error);
+}
+
+TEST_CASE("Async call dropped by executor", "[async]") {
+  auto executor = DeferredExecutor{};
+  const auto wrapper = make_wrapper();
+
+  auto result = gte::call_async<TheAnswer>(wrapper, executor);
+  CHECK(!result.ready());
+  executor.m_tasks.clear();
+  CHECK(result.ready());
+  try {
+    result.get();
+    CHECK(false);
+  } catch (const std::future_error &error) {
+    CHECK(error.code() == std::future_errc::broken_promise);
+  }
+}
+
+TEST_CASE("Async call on thread pool", "[async]") {
+  auto pool = gte::ThreadPool{4};
+  CHECK(pool.num_threads() == 4);
+
+  SECTION("Concurrent const calls") {
+    const auto wrapper = make_wrapper();
+    auto results = std::vector<gte::Future<int>>{};
+    constexpr auto num_calls = 100;
+    for (auto index = 0; index < num_calls; ++index) {
+      results.push_back(
+          gte::call_async<Multiply>(wrapper, pool, std::vector<int>{index}));
+    }
+    for (auto index = 0; index < num_calls; ++index) {
+      CHECK(results.at(index).get() == 42 * index);
+    }
+  }
+  SECTION("Queued tasks finish on destruction") {
+    auto counter = std::atomic<int>{0};
+    {
+      auto local_pool = gte::ThreadPool{2};
+      for (auto index = 0; index < 10; ++index) {
+        local_pool.execute([&counter] { ++counter; });
+      }
+    }
+    CHECK(counter == 10);
+  }
+}
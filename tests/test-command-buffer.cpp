@@ -0,0 +1,232 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+#include "command-buffer.hpp"
+#include "generic-type-erasure.hpp"
+
+namespace {
+struct Append {};
+struct Log {};
+struct Fail {};
+struct Keep {};
+using AppendFunction = gte::MemberSignature<Append, void(const std::string &)>;
+using LogFunction = gte::MemberSignature<Log, void(std::vector<std::string> &)>;
+using FailFunction = gte::MemberSignature<Fail, void()>;
+using KeepFunction = gte::MemberSignature<Keep, void(std::shared_ptr<int>)>;
+using Recorder = gte::TypeErased<AppendFunction, LogFunction, FailFunction,
+                                 KeepFunction>;
+using Buffer = gte::CommandBuffer<Recorder>;
+
+struct Cat {
+  std::string m_text;
+
+  void append(const std::string &text) { m_text += text; }
+  void log(std::vector<std::string> &entries) { entries.push_back("cat"); }
+  void fail() { throw std::runtime_error{"fail"}; }
+  void keep(std::shared_ptr<int>) {}
+};
+
+struct Dog {
+  std::string m_text;
+
+  void append(const std::string &text) { m_text += text; }
+  void log(std::vector<std::string> &entries) { entries.push_back("dog"); }
+  void fail() { throw std::runtime_error{"fail"}; }
+  void keep(std::shared_ptr<int>) {}
+};
+
+auto make_cat() -> Recorder {
+  return Recorder{Cat{}, &Cat::append, &Cat::log, &Cat::fail, &Cat::keep};
+}
+
+auto make_dog() -> Recorder {
+  return Recorder{Dog{}, &Dog::append, &Dog::log, &Dog::fail, &Dog::keep};
+}
+
+auto text(const Recorder &recorder) -> std::string {
+  if (const auto *cat = recorder.target<Cat>()) {
+    return cat->m_text;
+  }
+  return recorder.target<Dog>()->m_text;
+}
+
+struct Count {};
+struct Widen {};
+
+struct alignas(std::max_align_t) Wide {
+  double value;
+};
+
+using CountFunction = gte::MemberSignature<Count, void(int)>;
+using WidenFunction = gte::MemberSignature<Widen, void(const Wide &)>;
+using Aligned = gte::TypeErased<CountFunction, WidenFunction>;
+using AlignedBuffer = gte::CommandBuffer<Aligned>;
+
+struct Counter {
+  int m_count = 0;
+  double m_total = 0.0;
+  bool m_aligned = true;
+
+  void count(const int count) { m_count += count; }
+
+  void widen(const Wide &wide) {
+    m_total += wide.value;
+    m_aligned = m_aligned &&
+                reinterpret_cast<std::uintptr_t>(&wide) % alignof(Wide) == 0;
+  }
+};
+}  // namespace
+
+TEST_CASE("Command buffer replay", "[command_buffer]") {
+  auto cat = make_cat();
+  auto buffer = Buffer{};
+  CHECK(buffer.empty());
+
+  buffer.record<Append>(cat, std::string{"meow"});
+  buffer.record<Append>(cat, "!");
+  CHECK(buffer.size() == 2);
+  CHECK(text(cat).empty());
+
+  buffer.apply();
+  CHECK(text(cat) == "meow!");
+  CHECK(buffer.empty());
+
+  buffer.apply();
+  CHECK(text(cat) == "meow!");
+}
+
+TEST_CASE("Command buffer replay order", "[command_buffer]") {
+  auto pets = std::vector<Recorder>{};
+  pets.push_back(make_cat());
+  pets.push_back(make_dog());
+  pets.push_back(make_cat());
+
+  auto entries = std::vector<std::string>{};
+  auto buffer = Buffer{};
+  for (auto round = 0; round < 2; ++round) {
+    for (auto &pet : pets) {
+      buffer.record<Log>(pet, std::ref(entries));
+    }
+  }
+
+  SECTION("Recorded") {
+    buffer.apply(gte::ReplayOrder::recorded);
+    CHECK(entries ==
+          std::vector<std::string>{"cat", "dog", "cat", "cat", "dog", "cat"});
+  }
+  SECTION("By object") {
+    buffer.apply(gte::ReplayOrder::by_object);
+    CHECK(entries ==
+          std::vector<std::string>{"cat", "cat", "dog", "dog", "cat", "cat"});
+  }
+  SECTION("By type") {
+    buffer.apply(gte::ReplayOrder::by_type);
+    const auto cat_first =
+        std::type_index{typeid(Cat)} < std::type_index{typeid(Dog)};
+    const auto expected =
+        cat_first ? std::vector<std::string>{"cat", "cat", "cat", "cat", "dog",
+                                             "dog"}
+                  : std::vector<std::string>{"dog", "dog", "cat", "cat", "cat",
+                                             "cat"};
+    CHECK(entries == expected);
+  }
+}
+
+TEST_CASE("Command buffer blocks", "[command_buffer]") {
+  auto cat = make_cat();
+  auto buffer = Buffer{128};
+  auto expected = std::string{};
+  for (auto round = 0; round < 3; ++round) {
+    for (auto index = 0; index < 100; ++index) {
+      buffer.record<Append>(cat, std::to_string(index));
+      expected += std::to_string(index);
+    }
+    buffer.apply();
+    CHECK(text(cat) == expected);
+  }
+
+  const auto large = std::string(1000, 'x');
+  buffer.record<Append>(cat, large);
+  buffer.apply();
+  CHECK(text(cat) == expected + large);
+}
+
+TEST_CASE("Command buffer argument alignment", "[command_buffer]") {
+  auto counter = Aligned{Counter{}, &Counter::count, &Counter::widen};
+  auto buffer = AlignedBuffer{};
+  for (auto index = 0; index < 10; ++index) {
+    buffer.record<Count>(counter, 1);
+    buffer.record<Widen>(counter, Wide{0.5});
+  }
+  buffer.apply();
+
+  const auto &result = *counter.target<Counter>();
+  CHECK(result.m_count == 10);
+  CHECK(result.m_total == 5.0);
+  CHECK(result.m_aligned);
+}
+
+TEST_CASE("Command buffer destroys arguments", "[command_buffer]") {
+  auto cat = make_cat();
+  const auto argument = std::make_shared<int>(42);
+  auto buffer = Buffer{};
+
+  SECTION("Clear") {
+    buffer.record<Append>(cat, "a");
+    buffer.record<Keep>(cat, argument);
+    CHECK(argument.use_count() == 2);
+    buffer.clear();
+    CHECK(argument.use_count() == 1);
+    CHECK(buffer.empty());
+    CHECK(text(cat).empty());
+  }
+  SECTION("Destructor") {
+    {
+      auto moved = Buffer{};
+      moved.record<Keep>(cat, argument);
+      buffer = std::move(moved);
+    }
+    CHECK(argument.use_count() == 2);
+    buffer = Buffer{};
+    CHECK(argument.use_count() == 1);
+  }
+  SECTION("Exception") {
+    buffer.record<Append>(cat, "a");
+    buffer.record<Fail>(cat);
+    buffer.record<Append>(cat, "b");
+    CHECK_THROWS_AS(buffer.apply(), std::runtime_error);
+    CHECK(text(cat) == "a");
+    CHECK(buffer.empty());
+  }
+}
+
+TEST_CASE("Command buffer per thread producers", "[command_buffer]") {
+  auto pets = std::vector<Recorder>{};
+  pets.push_back(make_cat());
+  pets.push_back(make_dog());
+
+  auto buffers = std::vector<Buffer>(4);
+  auto producers = std::vector<std::thread>{};
+  for (auto &buffer : buffers) {
+    producers.emplace_back([&buffer, &pets] {
+      for (auto index = 0; index < 100; ++index) {
+        buffer.record<Append>(pets.at(index % 2), "x");
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (auto &buffer : buffers) {
+    buffer.apply(gte::ReplayOrder::by_object);
+  }
+  CHECK(text(pets.at(0)) == std::string(200, 'x'));
+  CHECK(text(pets.at(1)) == std::string(200, 'x'));
+}
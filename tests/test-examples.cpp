@@ -1,7 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 
+#include "command-buffer.hpp"
 #include "generic-type-erasure.hpp"
+#include "layout.hpp"
 
 namespace {
 struct Speak {};
@@ -46,6 +48,19 @@ TEST_CASE("Treat eater", "[examples]") {
   // object
 }
 
+TEST_CASE("Treat eater command buffer", "[examples]") {
+  auto cat = TreatEater{Cat{20}, &Cat::take_treat, &Cat::weight};
+  auto other_cat = TreatEater{Cat{10}, &Cat::take_treat, &Cat::weight};
+
+  auto buffer = gte::CommandBuffer<TreatEater>{};
+  buffer.record<GiveTreat>(cat, 2);
+  buffer.record<GiveTreat>(other_cat, 3);
+  buffer.apply(gte::ReplayOrder::by_type);
+
+  CHECK(cat.call<Weight>() == 22);
+  CHECK(other_cat.call<Weight>() == 13);
+}
+
 TEST_CASE("No hybrids", "[examples]") {
   //  const auto dog_cat_hybrid = Speaker{Dog{}, &Cat::meow}; // Cannot mix
   //  types and member functions
@@ -108,3 +123,35 @@ TEST_CASE("Full pet example", "[examples]") {
     pet.call<fe::Speak>();
   }
 }
+
+TEST_CASE("Full pet example with call_many", "[examples]") {
+  namespace fe = full_example;
+  auto my_pets = std::vector<fe::Pet>{fe::pet_from_cat(fe::Cat{10}),
+                                      fe::pet_from_dog(fe::Dog{50})};
+
+  for (auto& pet : my_pets) {
+    const auto [walked, treated, weight] =
+        pet.call_many<fe::TakeForAWalk, fe::GiveTreat, fe::Weight>(
+            std::tuple{}, std::tuple{10}, std::tuple{});
+    std::cout << "Current weight: " << weight << "\n";
+  }
+  CHECK(my_pets.front().call<fe::Weight>() == 19);
+  CHECK(my_pets.back().call<fe::Weight>() == 68);
+}
+
+TEST_CASE("Full pet example layout", "[examples]") {
+  namespace fe = full_example;
+  using Layout = gte::Layout<fe::Pet>;
+  using CatFootprint =
+      gte::Footprint<fe::Cat, decltype(&fe::Cat::meow),
+                     decltype(&fe::Cat::take_treat),
+                     decltype(&fe::Cat::walk), decltype(&fe::Cat::weight)>;
+  static_assert(Layout::dispatch_bytes <= 128);
+  static_assert(gte::Budget<256>::check<fe::Pet, CatFootprint>());
+#if defined(__GLIBCXX__) && defined(__x86_64__)
+  static_assert(Layout::total_bytes == 144);
+  static_assert(Layout::dispatch_bytes == 128);
+  static_assert(gte::detail::FootprintOf<fe::Pet, CatFootprint>::value == 208);
+#endif
+  CHECK(fe::pet_from_cat(fe::Cat{10}).call<fe::Weight>() == 10);
+}
@@ -0,0 +1,212 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+
+#include "function.hpp"
+
+namespace {
+auto add_one(const int value) -> int { return value + 1; }
+
+auto add_two(const int value) noexcept -> int { return value + 2; }
+
+class DestructionCounter {
+ public:
+  explicit DestructionCounter(int &destructions)
+      : m_destructions{&destructions} {}
+
+  DestructionCounter(DestructionCounter &&other) noexcept
+      : m_destructions{std::exchange(other.m_destructions, nullptr)} {}
+
+  DestructionCounter(const DestructionCounter &) = delete;
+
+  ~DestructionCounter() {
+    if (m_destructions != nullptr) {
+      ++*m_destructions;
+    }
+  }
+
+  auto operator()() const -> int { return 42; }
+
+ private:
+  int *m_destructions;
+};
+
+struct Counter {
+  int count = 0;
+
+  auto operator()() -> int { return ++count; }
+};
+}  // namespace
+
+TEST_CASE("Function call", "[function]") {
+  SECTION("Lambda") {
+    auto function =
+        gte::Function<int(int)>{[](int value) { return 2 * value; }};
+    CHECK(function(21) == 42);
+  }
+  SECTION("Free function") {
+    auto function = gte::Function<int(int)>{&add_one};
+    CHECK(function(41) == 42);
+  }
+  SECTION("Discarded return value") {
+    auto called = false;
+    auto function = gte::Function<void()>{[&called] {
+      called = true;
+      return 42;
+    }};
+    function();
+    CHECK(called);
+  }
+  SECTION("Mutable state") {
+    auto function = gte::Function<int()>{Counter{}};
+    CHECK(function() == 1);
+    CHECK(function() == 2);
+  }
+}
+
+TEST_CASE("Function empty", "[function]") {
+  CHECK(!gte::Function<void()>{});
+  CHECK(!gte::Function<void()>{nullptr});
+
+  using FunctionPointer = int (*)(int);
+  CHECK(!gte::Function<int(int)>{FunctionPointer{nullptr}});
+
+  auto function = gte::Function<int(int)>{&add_one};
+  CHECK(function);
+  function = nullptr;
+  CHECK(!function);
+}
+
+TEST_CASE("Function storage", "[function]") {
+  using SmallCapture = std::array<char, gte::default_function_inline_bytes>;
+  using LargeCapture =
+      std::array<char, gte::default_function_inline_bytes + 1>;
+  using Small = gte::Function<std::size_t()>;
+  using Large = gte::Function<std::size_t(), sizeof(LargeCapture)>;
+
+  const auto small_lambda = [capture = SmallCapture{}] {
+    return capture.size();
+  };
+  const auto large_lambda = [capture = LargeCapture{}] {
+    return capture.size();
+  };
+
+  static_assert(Small::stores_inline<decltype(small_lambda)>);
+  static_assert(!Small::stores_inline<decltype(large_lambda)>);
+  static_assert(Large::stores_inline<decltype(large_lambda)>);
+
+  auto heap_function = Small{large_lambda};
+  auto inline_function = Large{large_lambda};
+  CHECK(heap_function() == sizeof(LargeCapture));
+  CHECK(inline_function() == sizeof(LargeCapture));
+}
+
+TEST_CASE("Function move only", "[function]") {
+  auto function = gte::Function<int()>{
+      [pointer = std::make_unique<int>(42)] { return *pointer; }};
+  static_assert(!std::is_copy_constructible_v<decltype(function)>);
+
+  auto moved = std::move(function);
+  CHECK(!function);
+  CHECK(moved() == 42);
+
+  auto assigned = gte::Function<int()>{};
+  assigned = std::move(moved);
+  CHECK(!moved);
+  CHECK(assigned() == 42);
+}
+
+TEST_CASE("Function destroys callable", "[function]") {
+  auto destructions = 0;
+  SECTION("Inline") {
+    {
+      auto function = gte::Function<int()>{DestructionCounter{destructions}};
+      auto moved = std::move(function);
+      CHECK(moved() == 42);
+    }
+    CHECK(destructions == 1);
+  }
+  SECTION("Heap") {
+    {
+      auto function = gte::Function<int(), 0>{DestructionCounter{destructions}};
+      auto moved = std::move(function);
+      CHECK(moved() == 42);
+    }
+    CHECK(destructions == 1);
+  }
+  SECTION("Reset") {
+    auto function = gte::Function<int()>{DestructionCounter{destructions}};
+    function = nullptr;
+    CHECK(destructions == 1);
+  }
+}
+
+TEST_CASE("Function qualified signatures", "[function]") {
+  SECTION("Const") {
+    const auto function = gte::Function<int(int) const>{&add_one};
+    CHECK(function(41) == 42);
+    static_assert(
+        !std::is_constructible_v<gte::Function<int() const>, Counter>);
+  }
+  SECTION("Noexcept") {
+    auto function = gte::Function<int(int) noexcept>{&add_two};
+    static_assert(noexcept(function(40)));
+    CHECK(function(40) == 42);
+    static_assert(!std::is_constructible_v<gte::Function<int(int) noexcept>,
+                                           decltype(&add_one)>);
+  }
+  SECTION("Const noexcept") {
+    const auto function = gte::Function<int(int) const noexcept>{&add_two};
+    static_assert(noexcept(function(40)));
+    CHECK(function(40) == 42);
+  }
+}
+
+TEST_CASE("Function argument forwarding", "[function]") {
+  auto function = gte::Function<std::size_t(std::string &&)>{
+      [](std::string &&value) {
+        const auto moved = std::move(value);
+        return moved.size();
+      }};
+  auto value = std::string{"forty-two"};
+  CHECK(function(std::move(value)) == 9);
+
+  auto append = gte::Function<void(std::string &)>{
+      [](std::string &target) { target += "!"; }};
+  auto target = std::string{"woof"};
+  append(target);
+  CHECK(target == "woof!");
+}
+
+TEST_CASE("Function ref", "[function]") {
+  SECTION("Lambda") {
+    const auto lambda = [](int value) { return 2 * value; };
+    const auto function = gte::FunctionRef<int(int)>{lambda};
+    CHECK(function(21) == 42);
+  }
+  SECTION("Free function") {
+    CHECK(gte::FunctionRef<int(int)>{add_one}(41) == 42);
+    CHECK(gte::FunctionRef<int(int)>{&add_one}(41) == 42);
+  }
+  SECTION("Refers to the callable") {
+    auto counter = Counter{};
+    const auto function = gte::FunctionRef<int()>{counter};
+    CHECK(function() == 1);
+    CHECK(function() == 2);
+    CHECK(counter.count == 2);
+  }
+  SECTION("Qualified signatures") {
+    static_assert(
+        !std::is_constructible_v<gte::FunctionRef<int() const>, Counter &>);
+    const auto function = gte::FunctionRef<int(int) const noexcept>{add_two};
+    static_assert(noexcept(function(40)));
+    CHECK(function(40) == 42);
+  }
+  SECTION("Refers to a Function") {
+    auto owner = gte::Function<int()>{Counter{}};
+    const auto function = gte::FunctionRef<int()>{owner};
+    CHECK(function() == 1);
+    CHECK(owner() == 2);
+  }
+}
@@ -1,4 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "generic-type-erasure.hpp"
@@ -64,6 +66,12 @@ struct Tester {
       -> std::pair<unsigned, unsigned> {
     return {arg.copies(), arg.moves()};
   }
+
+  auto the_answer_noexcept() const noexcept -> int { return answer; }
+
+  void set_the_answer_noexcept(const int new_value) noexcept {
+    answer = new_value;
+  }
 };
 
 struct Tester2 {
@@ -336,3 +344,230 @@ TEST_CASE("Enforce constness", "[wrapper]") {
   // gte::detail::enforce_constness<decltype(&Tester::set_the_answer),
   // KeyWithConstSignature>();
 }
+
+TEST_CASE("Noexcept member functions", "[wrapper]") {
+  using TheAnswerFunction =
+      gte::ConstMemberSignature<TheAnswer, int() noexcept>;
+  using SetFunction = gte::MemberSignature<SetTheAnswer, void(int) noexcept>;
+  using MultiplyFunction =
+      gte::ConstMemberSignature<MultiplyTheAnswer, int(int)>;
+
+  auto wrapper =
+      gte::TypeErased<TheAnswerFunction, SetFunction, MultiplyFunction>{
+          Tester{}, &Tester::the_answer_noexcept,
+          &Tester::set_the_answer_noexcept, &Tester::multiply_the_answer};
+  const auto &const_wrapper = wrapper;
+
+  static_assert(noexcept(wrapper.call<TheAnswer>()));
+  static_assert(noexcept(const_wrapper.call<TheAnswer>()));
+  static_assert(noexcept(wrapper.call<SetTheAnswer>(43)));
+  static_assert(!noexcept(wrapper.call<MultiplyTheAnswer>(2)));
+  static_assert(!noexcept(const_wrapper.call<MultiplyTheAnswer>(2)));
+
+  wrapper.call<SetTheAnswer>(43);
+  CHECK(const_wrapper.call<TheAnswer>() == 43);
+  CHECK(const_wrapper.call<MultiplyTheAnswer>(2) == 86);
+}
+
+TEST_CASE("Noexcept argument conversions", "[wrapper]") {
+  struct Name {};
+  using NameFunction =
+      gte::MemberSignature<Name, std::size_t(std::string) noexcept>;
+  struct Named {
+    auto name(std::string name) noexcept -> std::size_t { return name.size(); }
+  };
+  struct ThrowingConversion {
+    operator std::string() const { throw std::runtime_error{"conversion"}; }
+  };
+
+  auto wrapper = gte::TypeErased<NameFunction>{Named{}, &Named::name};
+  static_assert(noexcept(wrapper.call<Name>(std::string{})));
+  static_assert(!noexcept(wrapper.call<Name>("rex")));
+  static_assert(!noexcept(wrapper.call<Name>(ThrowingConversion{})));
+
+  CHECK(wrapper.call<Name>("rex") == 3);
+  CHECK_THROWS_AS(wrapper.call<Name>(ThrowingConversion{}),
+                  std::runtime_error);
+}
+
+TEST_CASE("Enforce noexcept", "[wrapper]") {
+  using KeyWithSignature = gte::ConstMemberSignature<Key1, int()>;
+  static_assert(gte::detail::noexcept_matches<decltype(&Tester::the_answer),
+                                              KeyWithSignature>());
+  static_assert(
+      gte::detail::noexcept_matches<decltype(&Tester::the_answer_noexcept),
+                                    KeyWithSignature>());
+
+  using KeyWithNoexceptSignature =
+      gte::ConstMemberSignature<Key2, int() noexcept>;
+  static_assert(
+      gte::detail::noexcept_matches<decltype(&Tester::the_answer_noexcept),
+                                    KeyWithNoexceptSignature>());
+  static_assert(!gte::detail::noexcept_matches<decltype(&Tester::the_answer),
+                                               KeyWithNoexceptSignature>());
+  // The following commented code should not compile:
+  // gte::detail::enforce_noexcept<decltype(&Tester::the_answer),
+  // KeyWithNoexceptSignature>();
+}
+
+TEST_CASE("Noexcept map", "[wrapper]") {
+  using KeyWithSignature1 = gte::MemberSignature<Key1, int()>;
+  using KeyWithSignature2 = gte::ConstMemberSignature<Key2, int() noexcept>;
+  constexpr auto test_map =
+      gte::detail::noexcept_map<KeyWithSignature1, KeyWithSignature2>();
+
+  static_assert(!test_map.template get<Key1>());
+  static_assert(test_map.template get<Key2>());
+}
+
+TEST_CASE("Call many", "[wrapper]") {
+  using TheAnswerFunction = gte::ConstMemberSignature<TheAnswer, int()>;
+  using MultiplyFunction =
+      gte::ConstMemberSignature<MultiplyTheAnswer, int(int)>;
+  using SetFunction = gte::MemberSignature<SetTheAnswer, void(int) noexcept>;
+  using Wrapper =
+      gte::TypeErased<TheAnswerFunction, MultiplyFunction, SetFunction>;
+
+  auto wrapper =
+      Wrapper{Tester{}, &Tester::the_answer, &Tester::multiply_the_answer,
+              &Tester::set_the_answer_noexcept};
+
+  SECTION("Const") {
+    const auto &const_wrapper = wrapper;
+    const auto results = const_wrapper.call_many<TheAnswer, MultiplyTheAnswer>(
+        std::tuple{}, std::tuple{2});
+    static_assert(
+        std::is_same_v<std::remove_const_t<decltype(results)>,
+                       std::tuple<int, int> >);
+    CHECK(std::get<0>(results) == 42);
+    CHECK(std::get<1>(results) == 84);
+  }
+  SECTION("Called in order") {
+    const auto results =
+        wrapper.call_many<TheAnswer, SetTheAnswer, MultiplyTheAnswer>(
+            std::tuple{}, std::tuple{43}, std::tuple{2});
+    static_assert(std::is_same_v<std::remove_const_t<decltype(results)>,
+                                 std::tuple<int, std::monostate, int> >);
+    CHECK(std::get<0>(results) == 42);
+    CHECK(std::get<2>(results) == 86);
+    CHECK(wrapper.call<TheAnswer>() == 43);
+  }
+  SECTION("Forwarded arguments") {
+    using CopyMoveFunction =
+        gte::ConstMemberSignature<CopyCounter, std::pair<unsigned, unsigned>(
+                                                   CopyMoveCounter &&)>;
+    const auto counter_wrapper =
+        gte::TypeErased<CopyMoveFunction>{Tester{}, &Tester::r_value_ref_arg};
+    auto counter = CopyMoveCounter{};
+    const auto results = counter_wrapper.call_many<CopyCounter>(
+        std::forward_as_tuple(std::move(counter)));
+    CHECK(std::get<0>(results) == std::pair<unsigned, unsigned>{0, 0});
+  }
+}
+
+namespace {
+auto add_to_the_answer(const Tester &tester, const int value) -> int {
+  return tester.answer + value;
+}
+
+auto reset_the_answer(Tester &tester, const int value) noexcept -> int {
+  return std::exchange(tester.answer, value);
+}
+}  // namespace
+
+TEST_CASE("Data member binding", "[wrapper]") {
+  using TheAnswerFunction = gte::ConstMemberSignature<TheAnswer, int()>;
+  using SetFunction = gte::MemberSignature<SetTheAnswer, int(int)>;
+
+  auto wrapper = gte::TypeErased<TheAnswerFunction, SetFunction>{
+      Tester{}, gte::member<&Tester::answer>, &Tester::set_the_answer};
+  CHECK(wrapper.call<TheAnswer>() == 42);
+  wrapper.call<SetTheAnswer>(43);
+  CHECK(wrapper.call<TheAnswer>() == 43);
+}
+
+TEST_CASE("Free function bindings", "[wrapper]") {
+  using MultiplyFunction =
+      gte::ConstMemberSignature<MultiplyTheAnswer, int(int)>;
+  using SetFunction = gte::MemberSignature<SetTheAnswer, int(int) noexcept>;
+  using Wrapper = gte::TypeErased<MultiplyFunction, SetFunction>;
+
+  SECTION("Compile time") {
+    auto wrapper = Wrapper{Tester{}, gte::member<&add_to_the_answer>,
+                           gte::member<&reset_the_answer>};
+    static_assert(noexcept(wrapper.call<SetTheAnswer>(0)));
+    CHECK(wrapper.call<MultiplyTheAnswer>(1) == 43);
+    CHECK(wrapper.call<SetTheAnswer>(1) == 42);
+    CHECK(wrapper.call<MultiplyTheAnswer>(1) == 2);
+  }
+  SECTION("Function pointers") {
+    auto wrapper = Wrapper{Tester{}, &add_to_the_answer, reset_the_answer};
+    CHECK(wrapper.call<MultiplyTheAnswer>(1) == 43);
+    CHECK(wrapper.call<SetTheAnswer>(1) == 42);
+    CHECK(wrapper.call<MultiplyTheAnswer>(1) == 2);
+  }
+  SECTION("Lambdas") {
+    const auto offset = 10;
+    auto wrapper = Wrapper{
+        Tester{},
+        [offset](const Tester &tester, const int value) {
+          return tester.answer * value + offset;
+        },
+        [](Tester &tester, const int value) noexcept {
+          return std::exchange(tester.answer, value);
+        }};
+    CHECK(wrapper.call<MultiplyTheAnswer>(2) == 94);
+    CHECK(wrapper.call<SetTheAnswer>(1) == 42);
+    CHECK(wrapper.call<MultiplyTheAnswer>(2) == 12);
+  }
+}
+
+TEST_CASE("Binding helper", "[wrapper]") {
+  using NoArgs = std::tuple<>;
+  using DataMember = gte::detail::BindingHelper<decltype(&Tester::answer),
+                                                Tester, NoArgs, true>;
+  static_assert(DataMember::is_const);
+  static_assert(DataMember::is_stored);
+
+  using CompileTimeDataMember =
+      gte::detail::BindingHelper<gte::Member<&Tester::answer>, Tester, NoArgs,
+                                 false>;
+  static_assert(CompileTimeDataMember::is_const);
+  static_assert(!CompileTimeDataMember::is_stored);
+
+  using NonConstMember =
+      gte::detail::BindingHelper<decltype(&Tester::set_the_answer), Tester,
+                                 std::tuple<int>, false>;
+  static_assert(!NonConstMember::is_const);
+  static_assert(NonConstMember::is_invocable);
+  static_assert(!NonConstMember::is_noexcept);
+
+  const auto non_const_lambda = [](Tester &tester) { return tester.answer; };
+  using NonConstLambda = gte::detail::BindingHelper<decltype(non_const_lambda),
+                                                    Tester, NoArgs, true>;
+  static_assert(!NonConstLambda::is_const);
+  static_assert(NonConstLambda::is_invocable);
+
+  const auto const_lambda = [](const Tester &tester) { return tester.answer; };
+  using LambdaForNonConstTag =
+      gte::detail::BindingHelper<decltype(const_lambda), Tester, NoArgs, false>;
+  static_assert(!LambdaForNonConstTag::is_const);
+  static_assert(LambdaForNonConstTag::is_invocable);
+
+  using WrongObject = gte::detail::BindingHelper<decltype(non_const_lambda),
+                                                 Tester2, NoArgs, true>;
+  static_assert(!WrongObject::is_invocable);
+}
+
+TEST_CASE("Generic lambda bindings", "[wrapper]") {
+  using TheAnswerFunction = gte::ConstMemberSignature<TheAnswer, int()>;
+  using SetFunction = gte::MemberSignature<SetTheAnswer, int(int)>;
+
+  auto wrapper = gte::TypeErased<TheAnswerFunction, SetFunction>{
+      Tester{}, [](const auto &tester) { return tester.the_answer(); },
+      [](auto &tester, const int value) {
+        return tester.set_the_answer(value);
+      }};
+  CHECK(wrapper.call<SetTheAnswer>(43) == 42);
+  CHECK(wrapper.call<TheAnswer>() == 43);
+}
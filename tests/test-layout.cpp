@@ -0,0 +1,115 @@
+#include <any>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+#include "generic-type-erasure.hpp"
+#include "layout.hpp"
+#include "member.hpp"
+
+namespace {
+struct Weight {};
+using WeightFunction = gte::ConstMemberSignature<Weight, int()>;
+struct Name {};
+using NameFunction = gte::ConstMemberSignature<Name, std::string()>;
+using Pet = gte::TypeErased<WeightFunction, NameFunction>;
+using Weighable = gte::TypeErased<WeightFunction>;
+
+struct Mouse {
+  auto weight() const -> int { return 1; }
+  auto name() const -> std::string { return "mouse"; }
+};
+
+struct Elephant {
+  std::array<int, 1024> m_meals;
+
+  auto weight() const -> int { return 5000; }
+  auto name() const -> std::string { return "elephant"; }
+};
+}  // namespace
+
+TEST_CASE("Layout", "[layout]") {
+  using Layout = gte::Layout<Pet>;
+  static_assert(Layout::tag_count == 2);
+  static_assert(gte::Layout<Weighable>::tag_count == 1);
+  static_assert(Layout::object_bytes == sizeof(std::any));
+  static_assert(Layout::total_bytes == sizeof(Pet));
+  static_assert(Layout::dispatch_bytes ==
+                Layout::thunk_bytes + Layout::binding_bytes);
+  static_assert(Layout::dispatch_bytes + Layout::object_bytes <=
+                Layout::total_bytes);
+  static_assert(gte::Layout<Weighable>::dispatch_bytes <
+                Layout::dispatch_bytes);
+
+  const auto pet = Pet{Mouse{}, &Mouse::weight, &Mouse::name};
+  CHECK(pet.call<Weight>() == 1);
+}
+
+TEST_CASE("Layout inline storage", "[layout]") {
+  static_assert(!gte::stores_inline<Pet, Elephant>);
+  static_assert(gte::Layout<Pet>::footprint<Elephant> ==
+                sizeof(Pet) + sizeof(Elephant));
+#if defined(__GLIBCXX__) || defined(_LIBCPP_VERSION)
+  static_assert(gte::stores_inline<Pet, Mouse>);
+  static_assert(gte::stores_inline<Pet, const Mouse &>);
+  static_assert(gte::Layout<Pet>::footprint<Mouse> == sizeof(Pet));
+#endif
+}
+
+TEST_CASE("Layout binding storage", "[layout]") {
+  using Layout = gte::Layout<Pet>;
+  using WeightPointer = decltype(&Mouse::weight);
+  using NamePointer = decltype(&Mouse::name);
+  constexpr auto pointer_bytes =
+      gte::stores_inline<Pet, WeightPointer> ? 0 : sizeof(WeightPointer);
+  static_assert(Layout::binding_heap_bytes<> == 0);
+  static_assert(Layout::binding_heap_bytes<WeightPointer, NamePointer> ==
+                2 * pointer_bytes);
+  static_assert(Layout::footprint<Elephant, WeightPointer, NamePointer> ==
+                sizeof(Pet) + sizeof(Elephant) + 2 * pointer_bytes);
+#if defined(__GLIBCXX__)
+  static_assert(pointer_bytes == sizeof(WeightPointer));
+#endif
+
+  const auto stateless = [](const Mouse &mouse) { return mouse.weight(); };
+  const auto large = [meals = std::array<int, 16>{}](const Mouse &) {
+    return meals.at(0);
+  };
+  static_assert(
+      Layout::binding_heap_bytes<gte::Member<&Mouse::weight>,
+                                 decltype(stateless)> == 0);
+  static_assert(Layout::binding_heap_bytes<decltype(large)> ==
+                sizeof(large));
+#if __cplusplus > 201703L
+  static_assert(!gte::detail::is_stored_binding<decltype(stateless)>);
+#else
+  static_assert(gte::detail::is_stored_binding<decltype(stateless)>);
+#endif
+
+  const auto pet = Pet{Mouse{}, large, gte::member<&Mouse::name>};
+  CHECK(pet.call<Weight>() == 0);
+  CHECK(pet.call<Name>() == "mouse");
+}
+
+TEST_CASE("Budget", "[layout]") {
+  using Small = gte::Budget<sizeof(Pet)>;
+  using Large = gte::Budget<sizeof(Pet) + sizeof(Elephant)>;
+  static_assert(Large::check<Pet, Mouse, Elephant>());
+  static_assert(Large::fits<Pet, Mouse, Elephant>);
+  static_assert(Small::fits<Pet>);
+  static_assert(!Small::fits<Pet, Elephant>);
+  static_assert(!gte::Budget<sizeof(Pet) - 1>::fits<Pet>);
+  CHECK(Large::bytes == sizeof(Pet) + sizeof(Elephant));
+
+  using WeightPointer = decltype(&Mouse::weight);
+  using NamePointer = decltype(&Mouse::name);
+  using MouseFootprint = gte::Footprint<Mouse, WeightPointer, NamePointer>;
+  constexpr auto bound_bytes =
+      gte::Layout<Pet>::footprint<Mouse, WeightPointer, NamePointer>;
+  static_assert(gte::Budget<bound_bytes>::check<Pet, MouseFootprint>());
+  static_assert(!gte::Budget<bound_bytes - 1>::fits<Pet, MouseFootprint>);
+#if defined(__GLIBCXX__)
+  static_assert(Small::fits<Pet, Mouse>);
+  static_assert(!Small::fits<Pet, MouseFootprint>);
+#endif
+}
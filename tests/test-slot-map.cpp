@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "generic-type-erasure.hpp"
+#include "slot-map.hpp"
+
+namespace {
+struct Weight {};
+using WeightFunction = gte::ConstMemberSignature<Weight, int()>;
+struct Feed {};
+using FeedFunction = gte::MemberSignature<Feed, void(int)>;
+using Pets = gte::ErasedSlotMap<WeightFunction, FeedFunction>;
+using Pet = Pets::Wrapper;
+
+struct Cat {
+  int m_weight = 10;
+
+  auto weight() const -> int { return m_weight; }
+  void feed(const int amount) { m_weight += amount; }
+};
+
+struct Dog {
+  std::string m_name;
+  int m_weight = 20;
+
+  auto weight() const -> int { return m_weight; }
+  void feed(const int amount) { m_weight += 2 * amount; }
+};
+
+auto weights(const Pets &pets) -> std::vector<int> {
+  auto result = std::vector<int>{};
+  for (const auto &pet : pets) {
+    result.push_back(pet.call<Weight>());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+}  // namespace
+
+TEST_CASE("Slot handle", "[slot_map]") {
+  constexpr auto handle = gte::SlotHandle{3, 7};
+  static_assert(handle.index() == 3);
+  static_assert(handle.generation() == 7);
+  static_assert(gte::SlotHandle::from_value(handle.value()) == handle);
+  static_assert(gte::SlotHandle{} != handle);
+  static_assert(sizeof(gte::SlotHandle) == sizeof(std::uint64_t));
+}
+
+TEST_CASE("Slot map insert and call", "[slot_map]") {
+  auto pets = Pets{};
+  CHECK(pets.empty());
+  const auto cat = pets.emplace(Cat{}, &Cat::weight, &Cat::feed);
+  const auto dog = pets.insert(Pet{Dog{"rex"}, &Dog::weight, &Dog::feed});
+  CHECK(pets.size() == 2);
+  CHECK(cat != dog);
+
+  pets.call<Feed>(cat, 1);
+  pets.call<Feed>(dog, 1);
+  CHECK(pets.call<Weight>(cat) == 11);
+  CHECK(std::as_const(pets).call<Weight>(dog) == 22);
+  CHECK(pets.at(dog).target<Dog>()->m_name == "rex");
+  REQUIRE(pets.find(cat) != nullptr);
+  CHECK(pets.find(cat)->target<Cat>() != nullptr);
+  CHECK(pets.find(gte::SlotHandle{}) == nullptr);
+  CHECK_THROWS_AS(pets.call<Weight>(gte::SlotHandle{}), std::out_of_range);
+}
+
+TEST_CASE("Slot map erase", "[slot_map]") {
+  auto pets = Pets{};
+  auto handles = std::vector<gte::SlotHandle>{};
+  for (auto weight = 0; weight < 5; ++weight) {
+    handles.push_back(pets.emplace(Cat{weight}, &Cat::weight, &Cat::feed));
+  }
+
+  CHECK(pets.erase(handles.at(1)));
+  CHECK(!pets.erase(handles.at(1)));
+  CHECK(!pets.contains(handles.at(1)));
+  CHECK(pets.find(handles.at(1)) == nullptr);
+  CHECK_THROWS_AS(pets.at(handles.at(1)), std::out_of_range);
+  CHECK(pets.size() == 4);
+  CHECK(weights(pets) == std::vector<int>{0, 2, 3, 4});
+
+  // The remaining handles still refer to the same objects.
+  CHECK(pets.call<Weight>(handles.at(0)) == 0);
+  CHECK(pets.call<Weight>(handles.at(4)) == 4);
+
+  SECTION("Reused slots get a new generation") {
+    const auto reused = pets.emplace(Cat{42}, &Cat::weight, &Cat::feed);
+    CHECK(reused.index() == handles.at(1).index());
+    CHECK(reused.generation() != handles.at(1).generation());
+    CHECK(!pets.contains(handles.at(1)));
+    CHECK(pets.call<Weight>(reused) == 42);
+  }
+  SECTION("Clear") {
+    pets.clear();
+    CHECK(pets.empty());
+    for (const auto handle : handles) {
+      CHECK(!pets.contains(handle));
+    }
+  }
+}
+
+TEST_CASE("Slot map iteration", "[slot_map]") {
+  auto pets = Pets{};
+  pets.reserve(3);
+  const auto cat = pets.emplace(Cat{}, &Cat::weight, &Cat::feed);
+  pets.emplace(Dog{}, &Dog::weight, &Dog::feed);
+  pets.emplace(Cat{30}, &Cat::weight, &Cat::feed);
+  pets.erase(cat);
+
+  for (auto &pet : pets) {
+    pet.call<Feed>(1);
+  }
+  CHECK(weights(pets) == std::vector<int>{22, 31});
+
+  for (auto index = std::size_t{0}; index < pets.size(); ++index) {
+    const auto handle = pets.handle(index);
+    CHECK(&pets.at(handle) == &*(pets.begin() + index));
+  }
+}
+
+TEST_CASE("Slot map churn", "[slot_map]") {
+  auto pets = Pets{};
+  auto live = std::vector<std::pair<gte::SlotHandle, int> >{};
+  auto erased = std::vector<gte::SlotHandle>{};
+  for (auto round = 0; round < 1000; ++round) {
+    live.emplace_back(pets.emplace(Cat{round}, &Cat::weight, &Cat::feed),
+                      round);
+    if (round % 3 == 0) {
+      const auto position = live.begin() + (round * 7) % live.size();
+      CHECK(pets.erase(position->first));
+      erased.push_back(position->first);
+      live.erase(position);
+    }
+  }
+  CHECK(pets.size() == live.size());
+  for (const auto &[handle, weight] : live) {
+    REQUIRE(pets.contains(handle));
+    CHECK(pets.call<Weight>(handle) == weight);
+  }
+  for (const auto handle : erased) {
+    CHECK(!pets.contains(handle));
+  }
+}
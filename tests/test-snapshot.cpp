@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "generic-type-erasure.hpp"
+#include "snapshot.hpp"
+
+namespace {
+struct Weight {};
+using WeightFunction = gte::ConstMemberSignature<Weight, int()>;
+struct Name {};
+using NameFunction = gte::ConstMemberSignature<Name, std::string()>;
+using Pet = gte::TypeErased<WeightFunction, NameFunction>;
+
+struct Cat {
+  int m_weight = 10;
+
+  auto weight() const -> int { return m_weight; }
+  auto name() const -> std::string { return "cat"; }
+};
+
+struct Parrot {
+  std::string m_name;
+
+  auto weight() const -> int { return 1; }
+  auto name() const -> std::string { return m_name; }
+};
+
+auto pet_from_cat(Cat cat) -> Pet {
+  return Pet{std::move(cat), &Cat::weight, &Cat::name};
+}
+
+auto pet_from_parrot(Parrot parrot) -> Pet {
+  return Pet{std::move(parrot), &Parrot::weight, &Parrot::name};
+}
+
+auto make_registry() {
+  auto registry = gte::SnapshotRegistry<Pet>{};
+  registry.add<Cat>(1, &pet_from_cat);
+  registry.add<Parrot>(
+      2, &pet_from_parrot,
+      [](const Parrot &parrot, std::vector<std::byte> &bytes) {
+        const auto *begin =
+            reinterpret_cast<const std::byte *>(parrot.m_name.data());
+        bytes.insert(bytes.end(), begin, begin + parrot.m_name.size());
+      },
+      [](const std::byte *data, const std::size_t size) {
+        return Parrot{
+            std::string{reinterpret_cast<const char *>(data), size}};
+      });
+  return registry;
+}
+
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string &name)
+      : m_path{(std::filesystem::temp_directory_path() / name).string()} {}
+  TemporaryFile(const TemporaryFile &) = delete;
+  ~TemporaryFile() { std::filesystem::remove(m_path); }
+
+  auto path() const -> const std::string & { return m_path; }
+
+  auto read() const -> std::string {
+    auto file = std::ifstream{m_path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, {}};
+  }
+
+  void write(const std::string &contents) const {
+    auto file = std::ofstream{m_path, std::ios::binary | std::ios::trunc};
+    file << contents;
+  }
+
+ private:
+  std::string m_path;
+};
+
+auto save_pets(const TemporaryFile &file) {
+  const auto registry = make_registry();
+  const auto pets = std::vector<Pet>{pet_from_cat(Cat{12}),
+                                     pet_from_parrot(Parrot{"polly"}),
+                                     pet_from_cat(Cat{20})};
+  gte::save_snapshot(file.path(), pets, registry);
+}
+}  // namespace
+
+TEST_CASE("Snapshot round trip", "[snapshot]") {
+  const auto file = TemporaryFile{"gte-test-snapshot-round-trip"};
+  save_pets(file);
+
+  const auto registry = make_registry();
+  const auto snapshot = gte::Snapshot<Pet>{file.path(), registry};
+  REQUIRE(snapshot.size() == 3);
+
+  SECTION("Lazy") {
+    const auto parrot = snapshot.load(1);
+    CHECK(parrot.call<Name>() == "polly");
+    CHECK(parrot.target<Parrot>() != nullptr);
+    CHECK_THROWS_AS(snapshot.load(3), std::out_of_range);
+  }
+  SECTION("All") {
+    const auto pets = snapshot.load_all();
+    REQUIRE(pets.size() == 3);
+    CHECK(pets.at(0).call<Weight>() == 12);
+    CHECK(pets.at(1).call<Name>() == "polly");
+    CHECK(pets.at(2).call<Weight>() == 20);
+  }
+}
+
+TEST_CASE("Snapshot replacement", "[snapshot]") {
+  const auto file = TemporaryFile{"gte-test-snapshot-replacement"};
+  save_pets(file);
+  const auto contents = file.read();
+  const auto temporary_path = file.path() + ".tmp";
+  CHECK(!std::filesystem::exists(temporary_path));
+
+  // A directory in place of the temporary file makes the write fail.
+  std::filesystem::create_directory(temporary_path);
+  const auto registry = make_registry();
+  CHECK_THROWS_AS(gte::save_snapshot(file.path(), std::vector<Pet>{}, registry),
+                  gte::SnapshotError);
+  std::filesystem::remove(temporary_path);
+  CHECK(file.read() == contents);
+
+  gte::save_snapshot(file.path(), std::vector<Pet>{}, registry);
+  CHECK(gte::Snapshot<Pet>{file.path(), registry}.size() == 0);
+  CHECK(!std::filesystem::exists(temporary_path));
+}
+
+TEST_CASE("Snapshot registry lifetime", "[snapshot]") {
+  using Registry = gte::SnapshotRegistry<Pet>;
+  static_assert(std::is_constructible_v<gte::Snapshot<Pet>, const std::string &,
+                                        const Registry &>);
+  static_assert(!std::is_constructible_v<gte::Snapshot<Pet>,
+                                         const std::string &, Registry &&>);
+}
+
+TEST_CASE("Empty snapshot", "[snapshot]") {
+  const auto file = TemporaryFile{"gte-test-snapshot-empty"};
+  const auto registry = make_registry();
+  gte::save_snapshot(file.path(), std::vector<Pet>{}, registry);
+
+  const auto snapshot = gte::Snapshot<Pet>{file.path(), registry};
+  CHECK(snapshot.size() == 0);
+  CHECK(snapshot.load_all().empty());
+}
+
+TEST_CASE("Snapshot registration", "[snapshot]") {
+  auto registry = gte::SnapshotRegistry<Pet>{};
+  registry.add<Cat>(1, &pet_from_cat);
+  CHECK_THROWS_AS(registry.add<Cat>(2, &pet_from_cat), std::invalid_argument);
+
+  const auto file = TemporaryFile{"gte-test-snapshot-unregistered"};
+  const auto pets = std::vector<Pet>{pet_from_parrot(Parrot{"polly"})};
+  CHECK_THROWS_AS(gte::save_snapshot(file.path(), pets, registry),
+                  gte::SnapshotError);
+}
+
+TEST_CASE("Corrupt snapshots", "[snapshot]") {
+  const auto file = TemporaryFile{"gte-test-snapshot-corrupt"};
+  save_pets(file);
+  const auto contents = file.read();
+  const auto registry = make_registry();
+
+  SECTION("Missing file") {
+    CHECK_THROWS_AS(
+        gte::Snapshot<Pet>(file.path() + "-missing", registry),
+        gte::SnapshotError);
+  }
+  SECTION("Empty file") {
+    file.write("");
+    CHECK_THROWS_AS(gte::Snapshot<Pet>(file.path(), registry),
+                    gte::SnapshotError);
+  }
+  SECTION("Bad magic") {
+    auto corrupt = contents;
+    corrupt.at(0) = 'X';
+    file.write(corrupt);
+    CHECK_THROWS_AS(gte::Snapshot<Pet>(file.path(), registry),
+                    gte::SnapshotError);
+  }
+  SECTION("Truncated") {
+    file.write(contents.substr(0, contents.size() - 1));
+    CHECK_THROWS_AS(gte::Snapshot<Pet>(file.path(), registry),
+                    gte::SnapshotError);
+  }
+  SECTION("Corrupt payload") {
+    auto corrupt = contents;
+    corrupt.back() ^= 0x1;
+    file.write(corrupt);
+    const auto snapshot = gte::Snapshot<Pet>{file.path(), registry};
+    CHECK(snapshot.load(0).call<Weight>() == 12);
+    CHECK_THROWS_AS(snapshot.load(2), gte::SnapshotError);
+  }
+  SECTION("Corrupt record") {
+    // The first record is a Cat with type id 1; id 2 is a Parrot, which
+    // would load the Cat's bytes as a name.
+    auto corrupt = contents;
+    const auto type_id = sizeof(gte::detail::SnapshotHeader);
+    REQUIRE(corrupt.at(type_id) == '\x01');
+    corrupt.at(type_id) = '\x02';
+    file.write(corrupt);
+    const auto snapshot = gte::Snapshot<Pet>{file.path(), registry};
+    CHECK_THROWS_AS(snapshot.load(0), gte::SnapshotError);
+    CHECK(snapshot.load(1).call<Name>() == "polly");
+  }
+  SECTION("Unregistered type id") {
+    auto cats_only = gte::SnapshotRegistry<Pet>{};
+    cats_only.add<Cat>(1, &pet_from_cat);
+    const auto snapshot = gte::Snapshot<Pet>{file.path(), cats_only};
+    CHECK(snapshot.load(0).call<Weight>() == 12);
+    CHECK_THROWS_AS(snapshot.load(1), gte::SnapshotError);
+  }
+}
+
+TEST_CASE("Wrapper target", "[snapshot]") {
+  auto pet = pet_from_cat(Cat{12});
+  CHECK(pet.target_type() == typeid(Cat));
+  CHECK(pet.target<Parrot>() == nullptr);
+  REQUIRE(pet.target<Cat>() != nullptr);
+  pet.target<Cat>()->m_weight = 13;
+  CHECK(pet.call<Weight>() == 13);
+}
@@ -0,0 +1,96 @@
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+
+#include "static-type-erased.hpp"
+
+namespace {
+struct Handle {};
+struct Count {};
+struct Reset {};
+
+using HandleFunction = gte::ConstMemberSignature<Handle, int(int) noexcept>;
+using CountFunction = gte::ConstMemberSignature<Count, int()>;
+using ResetFunction = gte::MemberSignature<Reset, void(int)>;
+using Handler = gte::StaticTypeErased<HandleFunction>;
+using CountingHandler =
+    gte::StaticTypeErased<HandleFunction, CountFunction, ResetFunction>;
+
+struct AddHandler {
+  int offset = 0;
+
+  constexpr auto handle(const int value) const noexcept -> int {
+    return value + offset;
+  }
+};
+
+struct MultiplyHandler {
+  int factor = 1;
+  int count = 0;
+
+  constexpr auto handle(const int value) const noexcept -> int {
+    return value * factor;
+  }
+  auto calls() const -> int { return count; }
+  void reset(const int value) { count = value; }
+};
+
+AddHandler add_one{1};
+MultiplyHandler times_two{2};
+constexpr AddHandler add_two{2};
+
+constexpr auto registry = std::array{
+    Handler{add_one, gte::member<&AddHandler::handle>},
+    Handler{times_two, gte::member<&MultiplyHandler::handle>},
+    Handler{add_two, gte::member<&AddHandler::handle>}};
+
+#if defined(__cpp_constinit)
+constinit auto counting_handler = CountingHandler{
+    times_two, gte::member<&MultiplyHandler::handle>,
+    gte::member<&MultiplyHandler::calls>,
+    gte::member<&MultiplyHandler::reset>};
+#else
+auto counting_handler = CountingHandler{
+    times_two, gte::member<&MultiplyHandler::handle>,
+    gte::member<&MultiplyHandler::calls>,
+    gte::member<&MultiplyHandler::reset>};
+#endif
+}  // namespace
+
+TEST_CASE("Static registry", "[static]") {
+  static_assert(registry.size() == 3);
+  static_assert(noexcept(registry.front().call<Handle>(1)));
+
+  CHECK(registry.at(0).call<Handle>(41) == 42);
+  CHECK(registry.at(1).call<Handle>(21) == 42);
+  CHECK(registry.at(2).call<Handle>(40) == 42);
+}
+
+TEST_CASE("Static wrapper refers to the object", "[static]") {
+  counting_handler.call<Reset>(3);
+  CHECK(counting_handler.call<Count>() == 3);
+  CHECK(times_two.count == 3);
+
+  times_two.factor = 3;
+  CHECK(counting_handler.call<Handle>(14) == 42);
+  times_two.factor = 2;
+}
+
+TEST_CASE("Static wrapper of a local object", "[static]") {
+  auto handler = MultiplyHandler{4};
+  const auto wrapper = CountingHandler{
+      handler, gte::member<&MultiplyHandler::handle>,
+      gte::member<&MultiplyHandler::calls>,
+      gte::member<&MultiplyHandler::reset>};
+
+  wrapper.call<Reset>(7);
+  CHECK(handler.count == 7);
+  CHECK(wrapper.call<Handle>(10) == 40);
+}
+
+TEST_CASE("Static wrapper data member", "[static]") {
+  using OffsetFunction = gte::ConstMemberSignature<Count, int()>;
+  constexpr auto offset =
+      gte::StaticTypeErased<OffsetFunction>{add_two,
+                                            gte::member<&AddHandler::offset>};
+  CHECK(offset.call<Count>() == 2);
+}
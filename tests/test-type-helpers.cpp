@@ -12,6 +12,9 @@ struct Tester {
     answer = new_value;
     return old_answer;
   }
+
+  int forty_two_noexcept() const noexcept { return answer; }
+  void reset_noexcept() noexcept { answer = 42; }
 };
 
 struct FortyTwo {};
@@ -30,6 +33,28 @@ TEST_CASE("SignatureHelper static assertions", "[signaturehelper]") {
   static_assert(std::is_same_v<void, typename TestVoidIntDouble::ReturnType>);
   static_assert(std::is_same_v<std::tuple<int, double>,
                                typename TestVoidIntDouble::ArgTypes>);
+  static_assert(!TestVoidIntDouble::is_const);
+  static_assert(!TestVoidIntDouble::is_noexcept);
+}
+
+TEST_CASE("Qualified signature helper static assertions",
+          "[signaturehelper]") {
+  using TestConst = gte::detail::SignatureHelper<int(double) const>;
+  static_assert(std::is_same_v<int, typename TestConst::ReturnType>);
+  static_assert(
+      std::is_same_v<std::tuple<double>, typename TestConst::ArgTypes>);
+  static_assert(TestConst::is_const);
+  static_assert(!TestConst::is_noexcept);
+
+  using TestNoexcept = gte::detail::SignatureHelper<void() noexcept>;
+  static_assert(std::is_same_v<void, typename TestNoexcept::ReturnType>);
+  static_assert(!TestNoexcept::is_const);
+  static_assert(TestNoexcept::is_noexcept);
+
+  using TestConstNoexcept =
+      gte::detail::SignatureHelper<void(int) const noexcept>;
+  static_assert(TestConstNoexcept::is_const);
+  static_assert(TestConstNoexcept::is_noexcept);
 }
 
 TEST_CASE("Member function signature helper static assertions",
@@ -48,6 +73,20 @@ TEST_CASE("Member function signature helper static assertions",
   static_assert(
       std::is_same_v<typename TestNonConst::ArgTypes, std::tuple<int> >);
   static_assert(!TestNonConst::is_const);
+  static_assert(!TestNonConst::is_noexcept);
+
+  using TestConstNoexcept = gte::detail::MemberFunctionSignatureHelper<
+      decltype(&Tester::forty_two_noexcept)>;
+  static_assert(std::is_same_v<typename TestConstNoexcept::Name, Tester>);
+  static_assert(std::is_same_v<typename TestConstNoexcept::ReturnType, int>);
+  static_assert(TestConstNoexcept::is_const);
+  static_assert(TestConstNoexcept::is_noexcept);
+
+  using TestNoexcept = gte::detail::MemberFunctionSignatureHelper<
+      decltype(&Tester::reset_noexcept)>;
+  static_assert(std::is_same_v<typename TestNoexcept::ReturnType, void>);
+  static_assert(!TestNoexcept::is_const);
+  static_assert(TestNoexcept::is_noexcept);
 }
 
 TEST_CASE("Add arguments to signature helper", "[signaturehelper]") {
@@ -65,6 +104,15 @@ TEST_CASE("Add arguments to signature helper", "[signaturehelper]") {
                                ArgsFromWrapper>);
 }
 
+TEST_CASE("Add arguments to noexcept signature helper", "[signaturehelper]") {
+  using TestWrapperMemFun =
+      gte::detail::SignatureWithExtraArgs<int(double) noexcept,
+                                          const std::any &>;
+  static_assert(std::is_same_v<int(const std::any &,
+                                   std::tuple<double> &&) noexcept,
+                               typename TestWrapperMemFun::Signature>);
+}
+
 TEST_CASE("Pairs to tuples", "[pairstotuples]") {
   using Tuples = gte::detail::PairsToTuples<std::pair<int, double> >;
   static_assert(std::is_same_v<typename Tuples::FirstTuple, std::tuple<int> >);
@@ -17,28 +17,6 @@ TEST_CASE("Get index", "[typemap]") {
   static_assert(gte::detail::get_index<char, TestTuple>(indices) == 2);
 }
 
-TEST_CASE("Has type", "[typemap]") {
-  using TestTuple = std::tuple<Key1, int, Key2>;
-  constexpr auto indices =
-      std::make_index_sequence<std::tuple_size_v<TestTuple>>();
-
-  static_assert(gte::detail::has_type<Key1, TestTuple>(indices));
-  static_assert(gte::detail::has_type<Key2, TestTuple>(indices));
-  static_assert(gte::detail::has_type<int, TestTuple>(indices));
-  static_assert(!gte::detail::has_type<double, TestTuple>(indices));
-}
-
-TEST_CASE("Number of types", "[typemap]") {
-  using TestTuple = std::tuple<Key1, int, Key2, int>;
-  constexpr auto indices =
-      std::make_index_sequence<std::tuple_size_v<TestTuple>>();
-
-  static_assert(gte::detail::type_count<Key1, TestTuple>(indices) == 1);
-  static_assert(gte::detail::type_count<Key2, TestTuple>(indices) == 1);
-  static_assert(gte::detail::type_count<int, TestTuple>(indices) == 2);
-  static_assert(gte::detail::type_count<double, TestTuple>(indices) == 0);
-}
-
 TEST_CASE("All types unique", "[typemap]") {
   SECTION("Non-unique") {
     using TestTuple = std::tuple<Key1, int, Key2, int>;
@@ -70,3 +48,33 @@ TEST_CASE("Type map to constexpr bool", "[typemap]") {
   static_assert(test_map.get<Key1>());
   static_assert(!test_map.get<Key2>());
 }
+
+TEST_CASE("Unique index", "[typemap]") {
+  using TestTuple = std::tuple<Key1, int, Key2, int>;
+
+  static_assert(gte::detail::UniqueIndex<Key1, TestTuple>::found);
+  static_assert(gte::detail::UniqueIndex<Key1, TestTuple>::value == 0);
+  static_assert(gte::detail::UniqueIndex<Key2, TestTuple>::value == 2);
+  static_assert(!gte::detail::UniqueIndex<int, TestTuple>::found);
+  static_assert(!gte::detail::UniqueIndex<double, TestTuple>::found);
+}
+
+namespace {
+template <std::size_t I>
+struct IndexedKey {};
+
+template <std::size_t... Indices>
+constexpr auto sum_of_large_map(std::index_sequence<Indices...>)
+    -> std::size_t {
+  using LargeMap =
+      gte::TypeMap<std::pair<IndexedKey<Indices>, std::size_t>...>;
+  constexpr auto map = LargeMap{Indices...};
+  return (map.template get<IndexedKey<Indices>>() + ...);
+}
+}  // namespace
+
+TEST_CASE("Large type map", "[typemap]") {
+  constexpr auto num_keys = std::size_t{64};
+  static_assert(sum_of_large_map(std::make_index_sequence<num_keys>()) ==
+                num_keys * (num_keys - 1) / 2);
+}